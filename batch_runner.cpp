@@ -0,0 +1,348 @@
+#include "batch_runner.h"
+#include "flow_shop.h"
+#include "lower_bound.h"
+#include "no_wait.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+static std::string trim(const std::string &text) {
+    std::size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos) {
+        return "";
+    }
+    return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+}
+
+static std::vector<std::string> split_list(const std::string &value) {
+    std::vector<std::string> items;
+    std::stringstream stream(value);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        item = trim(item);
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+// Parses "1, 3, 5..8" into 1 3 5 6 7 8
+static bool parse_int_list(const std::string &value, std::vector<int> &numbers) {
+    numbers.clear();
+    try {
+        for (const std::string &item: split_list(value)) {
+            std::size_t range = item.find("..");
+            if (range == std::string::npos) {
+                numbers.push_back(std::stoi(item));
+                continue;
+            }
+            int first = std::stoi(item.substr(0, range));
+            int last = std::stoi(item.substr(range + 2));
+            for (int number = first; number <= last; ++number) {
+                numbers.push_back(number);
+            }
+        }
+    } catch (std::logic_error &) {
+        return false;
+    }
+    return !numbers.empty();
+}
+
+static bool parse_objectives(const std::string &value, std::vector<Objective> &objectives) {
+    objectives.clear();
+    for (const std::string &item: split_list(value)) {
+        Objective objective;
+        if (!parse_objective(item, objective)) {
+            return false;
+        }
+        objectives.push_back(objective);
+    }
+    return !objectives.empty();
+}
+
+static bool parse_setting(const std::string &key, const std::string &value, SweepSpec &spec) {
+    std::vector<int> numbers;
+    if (key == "instance_files") {
+        spec.instance_files = split_list(value);
+        return true;
+    } else if (key == "distribution") {
+        return parse_time_distribution(value, spec.distribution);
+    } else if (key == "objectives") {
+        return parse_objectives(value, spec.objectives);
+    } else if (key == "jobs") {
+        return parse_int_list(value, spec.jobs);
+    } else if (key == "machines") {
+        return parse_int_list(value, spec.machines);
+    } else if (key == "instance_seeds") {
+        return parse_int_list(value, spec.instance_seeds);
+    } else if (key == "strategies") {
+        return parse_int_list(value, spec.strategies);
+    } else if (key == "seeds") {
+        // the engine draws a random seed for 0, which would make the run irreproducible
+        return parse_int_list(value, spec.seeds) &&
+               std::find(spec.seeds.begin(), spec.seeds.end(), 0) == spec.seeds.end();
+    } else if (key == "iterations" && parse_int_list(value, numbers) && numbers.size() == 1) {
+        spec.iterations = numbers[0];
+        return true;
+    } else if (key == "neighbors" && parse_int_list(value, numbers) && numbers.size() == 1) {
+        spec.neighbors = numbers[0];
+        return true;
+    } else if (key == "weights") {
+        std::string text = value;
+        text.erase(std::remove(text.begin(), text.end(), ' '), text.end());
+        return parse_criteria_weights(text, spec.combination);
+    } else if (key == "t0" && parse_int_list(value, numbers) && numbers.size() == 1) {
+        spec.t0 = numbers[0];
+        return true;
+    }
+    return false;
+}
+
+bool read_settings(const std::string &path,
+                   const std::function<bool(const std::string &key, const std::string &value)> &setting,
+                   std::string &error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "could not open " + path;
+        return false;
+    }
+    std::string line;
+    for (int number = 1; std::getline(file, line); ++number) {
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            continue;
+        }
+        std::size_t equals = line.find('=');
+        if (equals == std::string::npos || !setting(trim(line.substr(0, equals)), trim(line.substr(equals + 1)))) {
+            error = path + ":" + std::to_string(number) + ": invalid setting \"" + line + "\"";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool parse_sweep_spec(const std::string &path, SweepSpec &spec, std::string &error) {
+    if (!read_settings(path, [&spec](const std::string &key, const std::string &value) {
+        return parse_setting(key, value, spec);
+    }, error)) {
+        return false;
+    }
+    if (!has_criteria(spec.combination) &&
+        std::find(spec.objectives.begin(), spec.objectives.end(), Objective::weighted_sum) != spec.objectives.end()) {
+        error = path + ": the weighted_sum objective needs the weights setting";
+        return false;
+    }
+    return true;
+}
+
+bool sweep_instances(const SweepSpec &spec, std::vector<Instance> &instances, std::string &error) {
+    instances.clear();
+    for (const std::string &path: spec.instance_files) {
+        Instance instance;
+        if (!load_instance(path, instance)) {
+            error = "could not read the instance " + path;
+            return false;
+        }
+        if (instance.deadlines.empty()) {
+            generate_due_dates(instance, GeneratorOptions());
+        }
+        instances.push_back(instance);
+    }
+    GeneratorOptions generator;
+    generator.distribution = spec.distribution;
+    generator.threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int jobs_num: spec.jobs) {
+        for (int machines_num: spec.machines) {
+            for (int seed: spec.instance_seeds) {
+                generator.seed = seed;
+                instances.push_back(generate_instance(jobs_num, machines_num, generator));
+            }
+        }
+    }
+    return true;
+}
+
+std::vector<BatchTask> expand_sweep(const SweepSpec &spec, const std::vector<Instance> &instances) {
+    std::vector<BatchTask> tasks;
+    for (std::size_t k = 0; k < instances.size(); ++k) {
+        // every neighbor evaluation touches up to jobs_num * machines_num cells
+        double cost = static_cast<double>(spec.iterations) * spec.neighbors * instances[k].jobs_num *
+                      instances[k].machines_num;
+        for (Objective objective: spec.objectives) {
+            for (int strategy: spec.strategies) {
+                for (int seed: spec.seeds) {
+                    tasks.push_back({static_cast<int>(k), objective, strategy, static_cast<unsigned>(seed), cost});
+                }
+            }
+        }
+    }
+    std::stable_sort(tasks.begin(), tasks.end(), [](const BatchTask &a, const BatchTask &b) {
+        return a.expected_cost > b.expected_cost;
+    });
+    return tasks;
+}
+
+// Read-only data of an instance, built once and shared by all runs on it
+struct SharedInstance {
+    std::vector<std::vector<int>> jobs;
+    std::vector<int> deadlines;
+    int lower_bound;
+    std::shared_ptr<SetupTimes> setups;  // null for instances without setup times
+};
+
+// A task deque of one worker, the owner and thieves both take from the front
+struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<int> tasks;
+};
+
+static bool take_task(std::vector<WorkerQueue> &queues, int worker, int &task, long long &steals) {
+    {
+        std::lock_guard<std::mutex> lock(queues[worker].mutex);
+        if (!queues[worker].tasks.empty()) {
+            task = queues[worker].tasks.front();
+            queues[worker].tasks.pop_front();
+            return true;
+        }
+    }
+    // steal from the fullest queue, retrying while any queue still has work
+    while (true) {
+        int victim = -1;
+        std::size_t most = 0;
+        for (std::size_t k = 0; k < queues.size(); ++k) {
+            std::lock_guard<std::mutex> lock(queues[k].mutex);
+            if (queues[k].tasks.size() > most) {
+                most = queues[k].tasks.size();
+                victim = k;
+            }
+        }
+        if (victim < 0) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(queues[victim].mutex);
+        if (!queues[victim].tasks.empty()) {
+            task = queues[victim].tasks.front();
+            queues[victim].tasks.pop_front();
+            ++steals;
+            return true;
+        }
+    }
+}
+
+BatchStats run_batch(const SweepSpec &spec, const std::vector<Instance> &instances,
+                     const std::vector<BatchTask> &tasks, ObjectFunction object_f, const AnnealingOptions &options,
+                     int threads, ResultWriter &writer) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    std::vector<SharedInstance> shared(instances.size());
+    for (std::size_t k = 0; k < instances.size(); ++k) {
+        shared[k].jobs = jobs_matrix(instances[k]);
+        shared[k].deadlines = instances[k].deadlines;
+        shared[k].lower_bound = taillard_lower_bound(shared[k].jobs, instances[k].jobs_num,
+                                                     instances[k].machines_num).value;
+        if (!instances[k].setups.empty()) {
+            shared[k].setups = std::make_shared<SetupTimes>(instances[k].jobs_num, instances[k].machines_num,
+                                                            instances[k].setups);
+        }
+    }
+
+    int workers = threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    workers = std::max(1, std::min<int>(workers, tasks.size()));
+    std::vector<WorkerQueue> queues(workers);
+    for (std::size_t k = 0; k < tasks.size(); ++k) {
+        queues[k % workers].tasks.push_back(k);
+    }
+
+    std::mutex writer_mutex;
+    std::atomic<long long> evaluations(0), steals(0);
+    std::atomic<int> failed_writes(0), overflows(0);
+    auto work = [&](int worker) {
+        long long stolen = 0;
+        int index;
+        while (take_task(queues, worker, index, stolen)) {
+            const BatchTask &task = tasks[index];
+            const Instance &instance = instances[task.instance];
+            const SharedInstance &data = shared[task.instance];
+            int n = instance.jobs_num;
+            int m = instance.machines_num;
+            std::vector<int> start(n);
+            for (int j = 0; j < n; ++j) {
+                start[j] = j + 1;
+            }
+            std::shuffle(start.begin(), start.end(), std::mt19937(task.seed));
+            AnnealingOptions run_options = options;
+            run_options.seed = task.seed;
+            run_options.combination = spec.combination;
+            run_options.lower_bound = task.objective == Objective::c_max
+                                      ? data.lower_bound
+                                      : trivial_lower_bound(task.objective, spec.combination);
+            run_options.setups = data.setups.get();
+            run_options.job_weights = instance.weights;
+            bool no_wait = task.objective == Objective::no_wait_c_max;
+            ObjectFunction run_f = no_wait ? no_wait_object_function : object_f;
+            AnnealingStats stats;
+            auto run_start = std::chrono::high_resolution_clock::now();
+            std::vector<int> order = simulated_annealing(task.objective, data.jobs, start, run_f, spec.iterations,
+                                                         spec.neighbors, spec.t0, n, m, task.cooling_strategy,
+                                                         data.deadlines, run_options, &stats);
+            double runtime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() -
+                                                           run_start).count();
+            evaluations += stats.evaluations;
+            if (!stats.overflow.empty()) {
+                ++overflows;  // the order of a run that ended early is no result
+                continue;
+            }
+            RunMetadata metadata = {objective_info(task.objective).name, instance.name, n, m,
+                                    spec.iterations, spec.neighbors, task.cooling_strategy, spec.t0, task.seed,
+                                    stats.evaluations, runtime};
+            ResultRecord record;
+            try {
+                ObjectFunctionResult result = data.setups && !no_wait
+                                              ? setup_object_function(data.jobs, *data.setups, order, n, m,
+                                                                      data.deadlines)
+                                              : run_f(data.jobs, order, n, m, data.deadlines);
+                Deadlines metrics = calculate_deadlines(data.jobs, result.job_end, data.deadlines, order);
+                CriteriaValues criteria = schedule_criteria(result.job_end, order, data.deadlines,
+                                                            instance.weights);
+                record = make_result_record(
+                        metadata, order,
+                        combine_criteria(criteria, criteria_weights(task.objective, spec.combination)), criteria,
+                        metrics);
+            } catch (std::overflow_error &) {
+                ++overflows;  // a criterion the objective does not weight may overflow as well
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(writer_mutex);
+            if (!writer.write(record)) {
+                ++failed_writes;
+            }
+        }
+        steals += stolen;
+    };
+    std::vector<std::thread> pool;
+    for (int worker = 1; worker < workers; ++worker) {
+        pool.emplace_back(work, worker);
+    }
+    work(0);
+    for (std::thread &thread: pool) {
+        thread.join();
+    }
+
+    BatchStats stats;
+    stats.tasks = tasks.size();
+    stats.failed_writes = failed_writes;
+    stats.overflows = overflows;
+    stats.evaluations = evaluations;
+    stats.steals = steals;
+    stats.runtime_seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() -
+                                                          start_time).count();
+    return stats;
+}
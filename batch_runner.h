@@ -0,0 +1,146 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "instance_generator.h"
+#include "result_export.h"
+#include "sequence_evaluator.h"
+#include "simulated_annealing.h"
+
+/**
+ * @brief Struct representing a sweep specification.
+ *
+ * A sweep runs every combination of instance, objective, cooling strategy and seed.
+ * The instances are the instance files plus one generated instance for every
+ * combination of jobs, machines and instance seed.
+ *
+ * The specification file has one "key = value, value, ..." setting per line, '#'
+ * starts a comment, and integer lists accept ranges such as "1..5". The keys are
+ * instance_files, jobs, machines, instance_seeds, distribution, objectives (names of
+ * the objective registry, see objective_registry()), weights (the coefficients of the
+ * weighted_sum objective as in parse_criteria_weights(), required with it), strategies,
+ * seeds, iterations, neighbors and t0. Seeds must not be 0, which the engine would
+ * replace by a random seed.
+ */
+struct SweepSpec {
+    std::vector<std::string> instance_files;
+    std::vector<int> jobs;
+    std::vector<int> machines;
+    std::vector<int> instance_seeds;
+    TimeDistribution distribution = TimeDistribution::taillard;
+    std::vector<Objective> objectives = {Objective::c_max};
+    CriteriaWeights combination;
+    std::vector<int> strategies = {1, 2, 3, 4, 5, 6};
+    std::vector<int> seeds = {1};
+    int iterations = 1000;
+    int neighbors = 100;
+    int t0 = 100;
+};
+
+/**
+ * @brief Struct representing one run of a sweep.
+ *
+ * - instance: The index of the instance in the instance list of the sweep.
+ * - expected_cost: The estimated work of the run, used to start long runs first.
+ */
+struct BatchTask {
+    int instance;
+    Objective objective;
+    int cooling_strategy;
+    unsigned seed;
+    double expected_cost;
+};
+
+/**
+ * @brief Struct representing the statistics of a batch.
+ *
+ * - overflows: The number of runs an objective value or a criterion of the result overflowed
+ *   in; they write no record.
+ */
+struct BatchStats {
+    int tasks = 0;
+    int failed_writes = 0;
+    int overflows = 0;
+    long long evaluations = 0;
+    long long steals = 0;
+    double runtime_seconds = 0;
+};
+
+/**
+ * @brief Read a settings file with one "key = value" setting per line.
+ *
+ * Blank lines are skipped and '#' starts a comment.
+ *
+ * @param path The path of the file.
+ * @param setting Called with every key and value; returns false if the setting is invalid.
+ * @param error Output for a description of the first problem found, with its line number.
+ *
+ * @return bool True if the file was read and every setting is valid.
+ */
+bool read_settings(const std::string &path,
+                   const std::function<bool(const std::string &key, const std::string &value)> &setting,
+                   std::string &error);
+
+/**
+ * @brief Read a sweep specification file.
+ *
+ * @param path The path of the file.
+ * @param spec Output for the specification; keys missing from the file keep their defaults.
+ * @param error Output for a description of the first problem found.
+ *
+ * @return bool True if the file was read and every line is valid.
+ */
+bool parse_sweep_spec(const std::string &path, SweepSpec &spec, std::string &error);
+
+/**
+ * @brief Load and generate the instances of a sweep.
+ *
+ * @param spec The sweep specification.
+ * @param instances Output for the instances, files first.
+ * @param error Output for a description of the first problem found.
+ *
+ * @return bool True if every instance file was read.
+ */
+bool sweep_instances(const SweepSpec &spec, std::vector<Instance> &instances, std::string &error);
+
+/**
+ * @brief Expand a sweep into its runs, longest expected run first.
+ *
+ * @param spec The sweep specification.
+ * @param instances The instances of the sweep, see sweep_instances().
+ *
+ * @return std::vector<BatchTask> The runs, sorted by decreasing expected cost.
+ */
+std::vector<BatchTask> expand_sweep(const SweepSpec &spec, const std::vector<Instance> &instances);
+
+/**
+ * @brief Run a batch of annealing runs on a work-stealing thread pool.
+ *
+ * The tasks are dealt round-robin, in the given order, to one deque per worker. A
+ * worker takes the front of its own deque and, when it runs dry, steals the front of
+ * the fullest other deque, so the longest remaining runs are always started first.
+ * The jobs matrices, deadlines and lower bounds are built once per instance and
+ * shared read-only by all runs. Every result is written to the writer as soon as
+ * its run ends.
+ *
+ * @param spec The sweep specification.
+ * @param instances The instances of the sweep.
+ * @param tasks The runs, see expand_sweep().
+ * @param object_f A function to calculate the objective function result of an order.
+ * @param options The settings of the engine; the seed is set per run.
+ * @param threads The number of worker threads, 0 uses every hardware thread.
+ * @param writer The writer the results are streamed to.
+ *
+ * @return BatchStats The statistics of the batch.
+ */
+BatchStats run_batch(const SweepSpec &spec,
+                     const std::vector<Instance> &instances,
+                     const std::vector<BatchTask> &tasks,
+                     ObjectFunction object_f,
+                     const AnnealingOptions &options,
+                     int threads,
+                     ResultWriter &writer);
+
+#endif // BATCH_RUNNER_H
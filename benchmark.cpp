@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "instance_generator.h"
+#include "neh.h"
+#include "objectives.h"
+#include "sequence_evaluator.h"
+#include "setup_times.h"
+#include "simd_kernels.h"
+#include "solver.h"
+#include "tardiness_seeds.h"
+
+// Benchmark of the hot loops of the solver. With --training it is the training run of the
+// profile-guided build and runs every instruction set the CPU supports, so none of the
+// kernel variants is left without a profile.
+
+struct BenchmarkInstance {
+    int jobs_num;
+    int machines_num;
+    int setup_max;
+};
+
+// Taillard's sizes with the machine counts of the specialized kernels, one generic count and one setup instance
+static const BenchmarkInstance INSTANCES[] = {
+        {20, 5, 0},
+        {50, 10, 0},
+        {100, 20, 0},
+        {60, 7, 0},
+        {50, 10, 20},
+};
+
+// Keeps the results alive so the compiler cannot drop the measured work
+static long long checksum = 0;
+
+static std::vector<int> random_order(int jobs_num, std::mt19937 &rng) {
+    std::vector<int> order(jobs_num);
+    for (int j = 0; j < jobs_num; ++j) {
+        order[j] = j + 1;
+    }
+    std::shuffle(order.begin(), order.end(), rng);
+    return order;
+}
+
+template<typename F>
+static void measure(const std::string &workload, const Instance &instance, long long operations, F run) {
+    auto start = std::chrono::steady_clock::now();
+    run();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::left << std::setw(16) << workload << std::setw(28) << instance.name << std::right
+              << std::fixed << std::setprecision(2) << std::setw(10) << seconds * 1000 << " ms"
+              << std::setw(12) << seconds * 1e9 / std::max(1LL, operations) << " ns/op\n";
+}
+
+static void run_instance(const BenchmarkInstance &size, int scale) {
+    GeneratorOptions options;
+    options.seed = 1000 + size.jobs_num * 31 + size.machines_num + size.setup_max;
+    options.setup_max = size.setup_max;
+    Instance instance = generate_instance(size.jobs_num, size.machines_num, options);
+    std::vector<std::vector<int>> jobs = jobs_matrix(instance);
+    int n = instance.jobs_num;
+    int m = instance.machines_num;
+    std::unique_ptr<SetupTimes> setups;
+    ObjectiveContext context;
+    if (!instance.setups.empty()) {
+        setups.reset(new SetupTimes(n, m, instance.setups));
+        context.setups = setups.get();
+    }
+    std::mt19937 rng(options.seed);
+
+    // incremental evaluation of random swaps, the inner loop of the annealing
+    long long swaps = 20000LL * scale;
+    for (Objective objective: {Objective::c_max, Objective::t_sum}) {
+        SequenceEvaluator evaluator(jobs, n, m, instance.deadlines, objective, &context);
+        std::vector<int> order = random_order(n, rng);
+        measure("evaluate_" + objective_info(objective).name, instance, swaps, [&]() {
+            evaluator.rebase(order);
+            for (long long k = 0; k < swaps; ++k) {
+                int a = rng() % n;
+                int b = rng() % n;
+                std::swap(order[a], order[b]);
+                checksum += evaluator.evaluate(order, std::min(a, b), std::max(a, b));
+                std::swap(order[a], order[b]);
+            }
+        });
+    }
+
+    // full evaluations, as in the polishing and the island fallback
+    long long orders = 500LL * scale;
+    std::vector<int> state;
+    measure("full_wsum", instance, orders, [&]() {
+        std::vector<int> order = random_order(n, rng);
+        for (long long k = 0; k < orders; ++k) {
+            std::swap(order[rng() % n], order[rng() % n]);
+            checksum += evaluate_order(jobs, m, instance.deadlines, Objective::weighted_tardiness, &context, order,
+                                       state);
+        }
+    });
+    if (setups == nullptr) {
+        TardinessWorkspace workspace;
+        measure("tardiness", instance, orders, [&]() {
+            std::vector<int> order = random_order(n, rng);
+            for (long long k = 0; k < orders; ++k) {
+                std::swap(order[rng() % n], order[rng() % n]);
+                checksum += total_tardiness(jobs, m, order, instance.deadlines, workspace);
+            }
+        });
+        // Taillard's insertion of every job, the batch neighbour evaluation
+        int repeats = std::max(1, scale / 2);
+        measure("neh", instance, static_cast<long long>(repeats) * n * n, [&]() {
+            for (int k = 0; k < repeats; ++k) {
+                checksum += neh(jobs, n, m)[0];
+            }
+        });
+    }
+
+    // a short in-process annealing run through the library, t0 = 0 calibrates the temperature
+    Solver solver;
+    std::string error;
+    SolverConfig config;
+    config.iterations = 200 * scale;
+    config.neighbors = 20;
+    config.constructive_start = false;
+    config.annealing.seed = options.seed;
+    config.annealing.moves = {MoveType::swap, MoveType::insertion};
+    config.annealing.adaptive_moves = true;
+    solver.configure(config);
+    if (!solver.set_instance(instance, error)) {
+        std::cerr << "Invalid instance: " << error << std::endl;
+        return;
+    }
+    measure("anneal_t_sum", instance, static_cast<long long>(config.iterations) * config.neighbors, [&]() {
+        if (!solver.solve(SolverCallback(), error)) {
+            std::cerr << "The annealing run failed: " << error << std::endl;
+        }
+    });
+    checksum += solver.result().value;
+}
+
+static void run_benchmark(int scale) {
+    std::cout << "SIMD kernels: " << isa_name(active_isa()) << "\n";
+    for (const BenchmarkInstance &size: INSTANCES) {
+        run_instance(size, scale);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int scale = 10;
+    bool training = false;
+    Isa isa = active_isa();
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--training") {
+            training = true;
+        } else if (arg.compare(0, 8, "--scale=") == 0) {
+            scale = std::max(1, std::stoi(arg.substr(8)));
+        } else if (arg.compare(0, 6, "--isa=") == 0 && parse_isa(arg.substr(6), isa)) {
+            if (!select_isa(isa)) {
+                std::cerr << "This CPU does not support " << isa_name(isa) << std::endl;
+                return 1;
+            }
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--scale=N] [--isa=generic|sse4.2|avx2|avx512] [--training]"
+                      << std::endl;
+            return 1;
+        }
+    }
+    if (training) {
+        const Isa variants[] = {Isa::generic, Isa::sse42, Isa::avx2, Isa::avx512};
+        Isa detected = active_isa();
+        for (Isa variant: variants) {
+            if (select_isa(variant)) {
+                run_benchmark(variant == detected ? scale : std::max(1, scale / 4));
+            }
+        }
+        select_isa(detected);
+    } else {
+        run_benchmark(scale);
+    }
+    std::cout << "Checksum: " << checksum << "\n";
+    return 0;
+}
@@ -1,11 +1,12 @@
 #include "cooling_strategies.h"
+#include <algorithm>
 
 double temp_lin_mult(int t0, double alpha, int t) {
     return t0 / (1 + (alpha * t));
 }
 
 double temp_lin_mult2(int t0, double alpha, int t) {
-    return t0 / (1 + alpha * (t * t));
+    return t0 / (1 + alpha * (static_cast<double>(t) * t));
 }
 
 double temp_exp_mult(int t0, double alpha, int t) {
@@ -21,7 +22,7 @@ double temp_non_monotonic(int f_star, int f_si, int t0, double alpha, int t) {
 }
 
 double choose_cooling_strategy(int cooling_strategy, int f_star, int f_si, int t0, double alpha, int t) {
-    double temp;
+    double temp = t0;
     if (cooling_strategy == 1) {
         temp = temp_lin_mult(t0, alpha, t);
     } else if (cooling_strategy == 2) {
@@ -48,6 +49,37 @@ std::string cooling_strategy_name(int cooling_strategy) {
         name = "Logarithmical Multiplicative";
     } else if (cooling_strategy == 5) {
         name = "Non-monotonic";
+    } else if (cooling_strategy == ADAPTIVE_COOLING) {
+        name = "Adaptive (Lam-Delosme)";
     }
     return name;
-}
\ No newline at end of file
+}
+// Keeps the temperature positive, so a frozen search can be heated up again
+static const double MIN_TEMPERATURE = 1e-9;
+
+AdaptiveCooling::AdaptiveCooling(double t0, long long horizon, double step, int window)
+        : t0_(t0), temperature_(t0), horizon_(horizon > 0 ? horizon : 1), step_(step),
+          smoothing_(1.0 / (window > 0 ? window : 1)), acceptance_rate_(1.0) {
+}
+
+void AdaptiveCooling::record(bool accepted, long long t) {
+    acceptance_rate_ += smoothing_ * ((accepted ? 1.0 : 0.0) - acceptance_rate_);
+    if (acceptance_rate_ > target_acceptance(t / horizon_)) {
+        temperature_ = std::max(temperature_ * step_, MIN_TEMPERATURE);
+    } else {
+        temperature_ /= step_;
+    }
+}
+
+void AdaptiveCooling::reheat(double fraction) {
+    temperature_ += fraction * (t0_ - temperature_);
+}
+
+double AdaptiveCooling::target_acceptance(double progress) {
+    if (progress < 0.15) {
+        return 0.44 + 0.56 * std::pow(560.0, -progress / 0.15);
+    } else if (progress < 0.65) {
+        return 0.44;
+    }
+    return 0.44 * std::pow(440.0, -(progress - 0.65) / 0.35);
+}
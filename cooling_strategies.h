@@ -4,6 +4,11 @@
 #include <cmath>
 #include <string>
 
+/**
+ * @brief Identifier of the adaptive cooling strategy, see AdaptiveCooling.
+ */
+const int ADAPTIVE_COOLING = 6;
+
 /**
  * @brief Linear multiplicative cooling strategy for simulated annealing.
  *
@@ -90,6 +95,8 @@ double temp_non_monotonic(int f_star, int f_si, int t0, double alpha, int t);
  *   - 3: Exponential multiplicative cooling.
  *   - 4: Logarithmic multiplicative cooling.
  *   - 5: Non-monotonic multiplicative cooling.
+ *   The adaptive strategy (ADAPTIVE_COOLING) keeps state between calls and is
+ *   provided by AdaptiveCooling instead; for it t0 is returned.
  * @param f_star Best-known objective function value.
  * @param f_si Current objective function value.
  * @param t0 Initial temperature.
@@ -112,9 +119,76 @@ double choose_cooling_strategy(int cooling_strategy, int f_star, int f_si, int t
  *   - 3: Exponential Multiplicative.
  *   - 4: Logarithmic Multiplicative.
  *   - 5: Non-monotonic.
+ *   - 6: Adaptive (Lam-Delosme).
  *
  * @return std::string The name of the specified cooling strategy.
  */
 std::string cooling_strategy_name(int cooling_strategy);
 
+/**
+ * @brief Feedback-controlled cooling that tracks the Lam-Delosme target acceptance rate.
+ *
+ * Instead of following a fixed function of time, the temperature is steered so that
+ * the running acceptance rate follows the Lam-Delosme curve over the progress of the
+ * run: it falls from 100% to 44% over the first 15%, stays at 44% until 65%, and then
+ * decays exponentially towards 0.1%. After every move the temperature is multiplied
+ * by step if the acceptance rate is above the target, and divided by it otherwise.
+ * The acceptance rate is an exponential moving average over about window moves, so
+ * the controller costs O(1) per move.
+ */
+class AdaptiveCooling {
+public:
+    /**
+     * @brief Construct a controller.
+     *
+     * @param t0 Initial temperature.
+     * @param horizon The number of moves of the run, the progress is t / horizon.
+     * @param step The factor the temperature changes by after every move (below 1).
+     * @param window The number of moves the acceptance rate is averaged over.
+     */
+    AdaptiveCooling(double t0, long long horizon, double step = 0.999, int window = 500);
+
+    /**
+     * @brief Get the current temperature.
+     */
+    double temperature() const { return temperature_; }
+
+    /**
+     * @brief Get the running acceptance rate.
+     */
+    double acceptance_rate() const { return acceptance_rate_; }
+
+    /**
+     * @brief Record whether a move was accepted and adjust the temperature.
+     *
+     * @param accepted True if the move was accepted.
+     * @param t The number of moves made so far.
+     */
+    void record(bool accepted, long long t);
+
+    /**
+     * @brief Raise the temperature part of the way back to the initial temperature.
+     *
+     * @param fraction The fraction of the gap to the initial temperature that is closed.
+     */
+    void reheat(double fraction);
+
+    /**
+     * @brief Get the Lam-Delosme target acceptance rate.
+     *
+     * @param progress The progress of the run between 0 and 1.
+     *
+     * @return double The target acceptance rate between 0 and 1.
+     */
+    static double target_acceptance(double progress);
+
+private:
+    double t0_;
+    double temperature_;
+    double horizon_;
+    double step_;
+    double smoothing_;
+    double acceptance_rate_;
+};
+
 #endif // COOLING_STRATEGIES_H
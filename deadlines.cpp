@@ -1,7 +1,10 @@
 #include "deadlines.h"
 #include <algorithm>
 #include <iostream>
-#include <iomanip>
+#include <cstdio>
+#include <string>
+#include "simd_kernels.h"
+#include "time_width.h"
 
 std::vector<int> generate_deadlines(int machines_num, int jobs_num, int deadline_length) {
     std::vector<int> deadlines;
@@ -14,18 +17,22 @@ std::vector<int> generate_deadlines(int machines_num, int jobs_num, int deadline
 }
 
 Deadlines calculate_deadlines(const std::vector<std::vector<int>> &jobs, const std::vector<std::vector<int>> &job_end,
-                              const std::vector<int> &deadlines) {
+                              const std::vector<int> &deadlines, const std::vector<int> &order) {
     int num_jobs = jobs.size();
-    std::vector<int> end_times = job_end.back();
+    std::vector<int> end_times(num_jobs);
     std::vector<int> jobs_l(num_jobs);
     std::vector<int> jobs_t(num_jobs);
 
+    for (int j = 0; j < num_jobs; ++j) {
+        end_times[order[j] - 1] = job_end.back()[j];
+    }
     for (int i = 0; i < num_jobs; ++i) {
-        jobs_l[i] = end_times[i] - deadlines[i];
-        jobs_t[i] = std::max(0, end_times[i] - deadlines[i]);
+        jobs_l[i] = checked_value(static_cast<long long>(end_times[i]) - deadlines[i]);
+        jobs_t[i] = std::max(0, jobs_l[i]);
     }
 
-    return {end_times, jobs_l, jobs_t, deadlines, jobs, std::accumulate(jobs_t.begin(), jobs_t.end(), 0)};
+    int t_sum = checked_value(simd_kernels().tardiness_sum(end_times.data(), deadlines.data(), num_jobs));
+    return {end_times, jobs_l, jobs_t, deadlines, jobs, t_sum};
 }
 
 void print_deadlines_table(const std::vector<int> &end_times,
@@ -33,18 +40,24 @@ void print_deadlines_table(const std::vector<int> &end_times,
                            const std::vector<int> &jobs_l,
                            const std::vector<int> &jobs_t,
                            const std::vector<int> &deadlines) {
-    std::cout << "DEADLINE TABLE:\n";
-
-    std::cout << std::setw(5) << "Ji" << std::setw(10) << "Ci" << std::setw(10) << "di" << std::setw(10) << "Li"
-              << std::setw(10) << "Ti" << std::endl;
-    std::cout << "------------------------------------------------\n";
+    // the whole table is formatted into one buffer and written at once
+    static const char RULE[] = "------------------------------------------------\n";
+    std::string table;
+    table.reserve((jobs.size() + 6) * 64);
+    char line[128];
+    table += "DEADLINE TABLE:\n";
+    std::snprintf(line, sizeof(line), "%5s%10s%10s%10s%10s\n", "Ji", "Ci", "di", "Li", "Ti");
+    table += line;
+    table += RULE;
     for (size_t i = 0; i < jobs.size(); ++i) {
-        std::cout << std::setw(5) << "J" << i + 1 << std::setw(10) << end_times[i] << std::setw(10) << deadlines[i]
-                  << std::setw(10) << jobs_l[i] << std::setw(10) << jobs_t[i] << std::endl;
+        std::snprintf(line, sizeof(line), "%5s%zu%10d%10d%10d%10d\n", "J", i + 1, end_times[i], deadlines[i],
+                      jobs_l[i], jobs_t[i]);
+        table += line;
     }
-
-    std::cout << "------------------------------------------------\n";
-    std::cout << std::setw(5) << "SUM" << std::setw(40) << std::setw(31)
-              << std::accumulate(jobs_l.begin(), jobs_l.end(), 0) << std::setw(11)
-              << std::accumulate(jobs_t.begin(), jobs_t.end(), 0) << std::endl;
+    table += RULE;
+    std::snprintf(line, sizeof(line), "%5s%31lld%11lld\n", "SUM", std::accumulate(jobs_l.begin(), jobs_l.end(), 0LL),
+                  std::accumulate(jobs_t.begin(), jobs_t.end(), 0LL));
+    table += line;
+    std::cout.flush();
+    std::fwrite(table.data(), 1, table.size(), stdout);
 }
\ No newline at end of file
@@ -24,12 +24,15 @@ struct Deadlines {
  * @brief Calculate job deadlines and related metrics based on job end times.
  *
  * The function takes as input the processing times of jobs, their end times,
- * and the provided deadlines. It computes the lateness and tardiness for each
- * job, as well as the total tardiness sum.
+ * the provided deadlines and the job order the end times belong to. It computes
+ * the lateness and tardiness for each job, as well as the total tardiness sum.
+ * The job_end matrix is indexed by position, the returned vectors and the
+ * deadlines are indexed by job.
  *
  * @param jobs A 2D vector representing the processing times of jobs on each machine.
  * @param job_end A 2D vector representing the end times of each job on each machine.
  * @param deadlines A vector representing the deadlines for each job.
+ * @param order A vector specifying the order in which jobs are processed.
  *
  * @return Deadlines A struct containing calculated metrics, including:
  * - end_times: The end times of each job in the last machine.
@@ -38,10 +41,13 @@ struct Deadlines {
  * - deadlines: The original deadlines provided.
  * - jobs: The processing times of jobs.
  * - t_sum: The total tardiness sum.
+ *
+ * @throws std::overflow_error If a lateness or the tardiness sum does not fit into an int.
  */
 Deadlines calculate_deadlines(const std::vector<std::vector<int>> &jobs,
                               const std::vector<std::vector<int>> &job_end,
-                              const std::vector<int> &deadlines);
+                              const std::vector<int> &deadlines,
+                              const std::vector<int> &order);
 
 /**
  * @brief Generate deadlines for jobs in a scheduling problem.
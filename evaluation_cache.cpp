@@ -0,0 +1,136 @@
+#include "evaluation_cache.h"
+#include <random>
+
+static const int PROBE_LENGTH = 4;
+static const uint64_t HASH_BASE = 0x9E3779B97F4A7C15ULL;  // odd, so invertible mod 2^64
+
+// Inverse of an odd number mod 2^64 by Newton iteration
+static uint64_t inverse(uint64_t x) {
+    uint64_t y = x;
+    for (int i = 0; i < 5; ++i) {
+        y *= 2 - x * y;
+    }
+    return y;
+}
+
+PermutationHasher::PermutationHasher(int jobs_num)
+        : keys_(jobs_num), pow_(2 * jobs_num + 1), inv_pow_(jobs_num + 1), base_(jobs_num),
+          prefix_(jobs_num + 1, 0), inv_prefix_(jobs_num + 1, 0) {
+    std::mt19937_64 rng(0x5EED0000ULL + jobs_num);
+    for (uint64_t &key: keys_) {
+        key = rng();
+    }
+    uint64_t inv_base = inverse(HASH_BASE);
+    pow_[0] = inv_pow_[0] = 1;
+    for (int p = 1; p <= 2 * jobs_num; ++p) {
+        pow_[p] = pow_[p - 1] * HASH_BASE;
+    }
+    for (int p = 1; p <= jobs_num; ++p) {
+        inv_pow_[p] = inv_pow_[p - 1] * inv_base;
+    }
+}
+
+uint64_t PermutationHasher::rebase(const std::vector<int> &sequence) {
+    int n = base_.size();
+    for (int p = 0; p < n; ++p) {
+        base_[p] = sequence[p];
+        prefix_[p + 1] = prefix_[p] + key(p) * pow_[p];
+        inv_prefix_[p + 1] = inv_prefix_[p] + key(p) * inv_pow_[p];
+    }
+    return prefix_[n];
+}
+
+uint64_t PermutationHasher::hash_after(const Move &move) const {
+    uint64_t h = prefix_.back();
+    int a = move.a;
+    int b = move.b;
+    if (move.type == MoveType::adjacent_swap || move.type == MoveType::swap) {
+        uint64_t diff = key(b) - key(a);
+        return h + diff * pow_[a] - diff * pow_[b];
+    } else if (move.type == MoveType::insertion) {
+        uint64_t moved = key(a);
+        if (a < b) {
+            uint64_t block = prefix_[b + 1] - prefix_[a + 1];  // shifts one position left
+            return h - moved * pow_[a] - block + block * inv_pow_[1] + moved * pow_[b];
+        }
+        uint64_t block = prefix_[a] - prefix_[b];  // shifts one position right
+        return h - moved * pow_[a] - block + block * pow_[1] + moved * pow_[b];
+    } else if (move.type == MoveType::block_move) {
+        int length = move.length;
+        uint64_t block = prefix_[a + length] - prefix_[a];
+        if (a < b) {
+            uint64_t rest = prefix_[b + length] - prefix_[a + length];
+            return h - block - rest + block * pow_[b - a] + rest * inv_pow_[length];
+        }
+        uint64_t rest = prefix_[a] - prefix_[b];
+        return h - block - rest + block * inv_pow_[a - b] + rest * pow_[length];
+    }
+    // reversal: the job at q moves to a + b - q
+    uint64_t segment = prefix_[b + 1] - prefix_[a];
+    uint64_t mirrored = (inv_prefix_[b + 1] - inv_prefix_[a]) * pow_[a + b];
+    return h - segment + mirrored;
+}
+
+EvaluationCache::EvaluationCache(std::size_t capacity) : hits_(0), misses_(0) {
+    std::size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    std::vector<Slot> slots(size);
+    slots_.swap(slots);
+    for (Slot &slot: slots_) {
+        slot.check.store(0, std::memory_order_relaxed);
+        slot.data.store(0, std::memory_order_relaxed);
+    }
+    mask_ = size - 1;
+}
+
+// Empty slots read as key 0, so key 0 is remapped
+static uint64_t slot_key(uint64_t key) {
+    return key != 0 ? key : 1;
+}
+
+bool EvaluationCache::find(uint64_t key, int &value) const {
+    key = slot_key(key);
+    for (int probe = 0; probe < PROBE_LENGTH; ++probe) {
+        const Slot &slot = slots_[(key + probe) & mask_];
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t check = slot.check.load(std::memory_order_relaxed);
+        if ((check ^ data) == key) {
+            value = static_cast<int>(static_cast<uint32_t>(data));
+            return true;
+        }
+    }
+    return false;
+}
+
+bool EvaluationCache::lookup(uint64_t key, int &value) {
+    if (find(key, value)) {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool EvaluationCache::contains(uint64_t key) const {
+    int value;
+    return find(key, value);
+}
+
+void EvaluationCache::insert(uint64_t key, int value) {
+    key = slot_key(key);
+    std::size_t target = key & mask_;
+    for (int probe = 0; probe < PROBE_LENGTH; ++probe) {
+        std::size_t index = (key + probe) & mask_;
+        uint64_t data = slots_[index].data.load(std::memory_order_relaxed);
+        uint64_t check = slots_[index].check.load(std::memory_order_relaxed);
+        if ((check == 0 && data == 0) || (check ^ data) == key) {
+            target = index;
+            break;
+        }
+    }
+    uint64_t data = static_cast<uint32_t>(value);
+    slots_[target].data.store(data, std::memory_order_relaxed);
+    slots_[target].check.store(key ^ data, std::memory_order_relaxed);
+}
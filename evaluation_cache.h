@@ -0,0 +1,119 @@
+#ifndef EVALUATION_CACHE_H
+#define EVALUATION_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "neighborhood.h"
+
+/**
+ * @brief Incremental hash of job orders.
+ *
+ * Zobrist-style hashing with position-weighted keys: every job has a random 64-bit
+ * key, and the hash of an order is the sum of key[job at p] * R^p over the positions
+ * p (mod 2^64, R odd and therefore invertible). After rebase() has stored the prefix
+ * sums of a base order, the hash of any neighbor produced by a single move is
+ * computed in O(1): a swap changes two terms, and an insertion, block move or
+ * reversal multiplies the prefix sum of a shifted block by a power of R.
+ */
+class PermutationHasher {
+public:
+    /**
+     * @brief Construct a hasher for orders of jobs_num jobs.
+     *
+     * The keys only depend on jobs_num, so hashers of the same instance agree and can
+     * share one EvaluationCache.
+     *
+     * @param jobs_num The total number of jobs.
+     */
+    explicit PermutationHasher(int jobs_num);
+
+    /**
+     * @brief Make an order the base order and return its hash. O(n).
+     */
+    uint64_t rebase(const std::vector<int> &sequence);
+
+    /**
+     * @brief Get the hash of the base order.
+     */
+    uint64_t hash() const { return prefix_.back(); }
+
+    /**
+     * @brief Get the hash of the base order after a move. O(1).
+     *
+     * @param move A move on the base order.
+     *
+     * @return uint64_t The hash of the moved order.
+     */
+    uint64_t hash_after(const Move &move) const;
+
+private:
+    uint64_t key(int position) const { return keys_[base_[position] - 1]; }
+
+    std::vector<uint64_t> keys_;
+    std::vector<uint64_t> pow_;      // R^p, up to 2n for mirrored reversal terms
+    std::vector<uint64_t> inv_pow_;  // R^-p
+    std::vector<int> base_;
+    std::vector<uint64_t> prefix_;      // sum of key * R^q for q < p
+    std::vector<uint64_t> inv_prefix_;  // sum of key * R^-q for q < p
+};
+
+/**
+ * @brief Fixed-size, lock-free cache from order hashes to objective values.
+ *
+ * Open addressing with a short linear probe. Every slot holds two 64-bit words, the
+ * data word and the key xor-ed with the data word, so a reader detects a slot that
+ * another thread is overwriting without taking a lock, and treats it as a miss.
+ * When the probe finds no free slot the first slot of the probe is overwritten.
+ *
+ * The cache doubles as a short-term tabu list: contains() tells whether an order was
+ * evaluated recently.
+ */
+class EvaluationCache {
+public:
+    /**
+     * @brief Construct a cache.
+     *
+     * @param capacity The number of slots, rounded up to a power of two.
+     */
+    explicit EvaluationCache(std::size_t capacity);
+
+    /**
+     * @brief Look up the objective value of an order.
+     *
+     * @param key The hash of the order.
+     * @param value Output for the cached value.
+     *
+     * @return bool True on a hit.
+     */
+    bool lookup(uint64_t key, int &value);
+
+    /**
+     * @brief Check whether an order is cached, without counting a hit or miss.
+     */
+    bool contains(uint64_t key) const;
+
+    /**
+     * @brief Store the objective value of an order.
+     */
+    void insert(uint64_t key, int value);
+
+    long long hits() const { return hits_.load(std::memory_order_relaxed); }
+    long long misses() const { return misses_.load(std::memory_order_relaxed); }
+    std::size_t capacity() const { return mask_ + 1; }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> check;
+        std::atomic<uint64_t> data;
+    };
+
+    bool find(uint64_t key, int &value) const;
+
+    std::vector<Slot> slots_;
+    std::size_t mask_;
+    std::atomic<long long> hits_;
+    std::atomic<long long> misses_;
+};
+
+#endif // EVALUATION_CACHE_H
@@ -1,30 +1,18 @@
 #include "flow_shop.h"
 #include <iostream>
 #include <string>
-#include <ctime>
 #include "deadlines.h"
+#include "gantt.h"
+#include "instance_generator.h"
 
-std::vector<std::vector<int>> jobs_input(int jobs_num, int machines_num) {
-    std::vector<std::vector<int>> jobs(jobs_num, std::vector<int>(machines_num, 0));
-
-    // Seed the random number generator with the current time
-    std::srand(static_cast<unsigned>(std::time(nullptr)));
-
-    for (int i = 0; i < jobs_num; ++i) {
-        for (int j = 0; j < machines_num; ++j) {
-            jobs[i][j] = std::rand() % 8 + 1;  // Generate a random number between 1 and 8
-        }
-    }
-
-//    jobs = {
-//            {3, 4, 6, 7},
-//            {4, 5, 4, 6},
-//            {8, 7, 2, 2},
-//            {5, 3, 1, 5},
-//            {7, 6, 8, 4}
-//    };
-
-    return jobs;
+std::vector<std::vector<int>> jobs_input(int jobs_num, int machines_num, unsigned long long seed) {
+    // Processing times between 1 and 8, reproducible from the seed
+    GeneratorOptions options;
+    options.seed = seed;
+    options.distribution = TimeDistribution::uniform;
+    options.min_time = 1;
+    options.max_time = 8;
+    return jobs_matrix(generate_instance(jobs_num, machines_num, options));
 }
 
 ObjectFunctionResult
@@ -47,11 +35,32 @@ object_function(const std::vector<std::vector<int>> &jobs, const std::vector<int
         }
     }
 
-    int t_sum = calculate_deadlines(jobs, job_end, deadlines).t_sum;
+    int t_sum = calculate_deadlines(jobs, job_end, deadlines, order).t_sum;
 
     return {cost[jobs_num - 1], t_sum, job_begin, job_end};
 }
 
+ObjectFunctionResult setup_object_function(const std::vector<std::vector<int>> &jobs, const SetupTimes &setups,
+                                           const std::vector<int> &order, int jobs_num, int machines_num,
+                                           const std::vector<int> &deadlines) {
+    std::vector<std::vector<int>> job_begin(machines_num, std::vector<int>(jobs_num, 0));
+    std::vector<std::vector<int>> job_end(machines_num, std::vector<int>(jobs_num, 0));
+    std::vector<int> state(machines_num, 0);
+    int c_max = 0;
+    for (int j = 0; j < jobs_num; ++j) {
+        const int *setup = j > 0 ? setups.row(order[j - 1], order[j]) : nullptr;
+        c_max = append_with_setup(jobs[order[j] - 1].data(), setup, machines_num, state.data());
+        for (int i = 0; i < machines_num; ++i) {
+            job_end[i][j] = state[i];
+            job_begin[i][j] = state[i] - jobs[order[j] - 1][i];
+        }
+    }
+
+    int t_sum = calculate_deadlines(jobs, job_end, deadlines, order).t_sum;
+
+    return {c_max, t_sum, job_begin, job_end};
+}
+
 int deadline_length(const std::vector<std::vector<int>> &jobs, const std::vector<int> &order, int jobs_num,
                     int machines_num) {
     std::vector<int> cost(jobs_num, 0);
@@ -67,41 +76,10 @@ int deadline_length(const std::vector<std::vector<int>> &jobs, const std::vector
     return cost[jobs_num - 1];
 }
 
-void print_flow_shop(int machines_num, int jobs_num, const std::vector<std::vector<int>> &job_begin,
+void print_flow_shop(const std::vector<std::vector<int>> &jobs, const std::vector<int> &order,
                      const std::vector<std::vector<int>> &job_end) {
-    std::vector<int> represent_job(jobs_num);
-    for (int i = 0; i < jobs_num; ++i) {
-        represent_job[i] = i + 1;
-    }
-
-    // printing the Gantt chart
-    std::cout << "\nFLOW-SHOP GANTT CHART:\n\n";
-    for (int i = 0; i < machines_num; ++i) {
-        for (int j = 0; j < jobs_num; ++j) {
-            if (j == 0 && job_begin[i][j] != 0) {
-                std::string segment = std::string(job_begin[i][j], '-');
-                for (char &ch: segment) {
-                    std::cout << ch << "|";
-                }
-            }
-            if (j < jobs_num - 1) {
-                std::string segment = std::string(job_end[i][j] - job_begin[i][j], '0' + represent_job[j]);
-                for (char &ch: segment) {
-                    std::cout << ch << "|";
-                }
-                std::string segment2 = std::string(job_begin[i][j + 1] - job_end[i][j], '-');
-                for (char &ch: segment2) {
-                    std::cout << ch << "|";
-                }
-            }
-            if (j == jobs_num - 1) {
-                std::string segment = std::string(job_end[i][j] - job_begin[i][j], '0' + represent_job[j]);
-                for (char &ch: segment) {
-                    std::cout << ch << "|";
-                }
-            }
-        }
-        std::cout << "\n\n";
-    }
-
-}
\ No newline at end of file
+    std::string chart;
+    render_gantt(chart, GanttFormat::text, jobs, order, job_end);
+    std::cout.flush();
+    write_buffer(stdout, chart);
+}
@@ -4,6 +4,7 @@
 #include <vector>
 #include "simulated_annealing.h"
 #include "deadlines.h"
+#include "setup_times.h"
 
 // Forward declaration of ObjectFunctionResult
 struct ObjectFunctionResult;
@@ -11,13 +12,15 @@ struct ObjectFunctionResult;
 /**
  * @brief Provides jobs and machines matrix.
  *
- * This function provides a matrix by generating random numbers for the jobs' lengths on each machine.
+ * This function provides a matrix by generating random numbers between 1 and 8 for the jobs' lengths
+ * on each machine. The same seed always gives the same matrix, see generate_instance().
  *
  * @param jobs_num number of jobs.
  * @param machines_num number of machines.
+ * @param seed The seed of the generator.
  * @return The jobs' matrix.
  */
-std::vector<std::vector<int>> jobs_input(int jobs_num, int machines_num);
+std::vector<std::vector<int>> jobs_input(int jobs_num, int machines_num, unsigned long long seed);
 
 /**
  * @brief Calculate various metrics related to job scheduling.
@@ -37,12 +40,43 @@ std::vector<std::vector<int>> jobs_input(int jobs_num, int machines_num);
  * including the total cost, total tardiness sum, and matrices for job start
  * and end times.
  */
+ObjectFunctionResult object_function(const std::vector<std::vector<int>> &jobs,
+                                     const std::vector<int> &order,
+                                     int jobs_num,
+                                     int machines_num,
+                                     const std::vector<int> &deadlines);
+
 using ObjectFunction = ObjectFunctionResult (*)(const std::vector<std::vector<int>>&,
                                                 const std::vector<int>&,
                                                 int,
                                                 int,
                                                 const std::vector<int>&);
 
+/**
+ * @brief Calculate the schedule of an order with sequence-dependent setup times.
+ *
+ * The counterpart of object_function() for instances with setup times: before a job
+ * runs on a machine, the machine performs the setup from the job before it, see
+ * append_with_setup(). The start times are those of the jobs themselves, after
+ * their setups.
+ *
+ * @param jobs A 2D vector representing the processing times of jobs on each machine.
+ * @param setups The sequence-dependent setup times.
+ * @param order A vector specifying the order in which jobs are processed.
+ * @param jobs_num An integer representing the total number of jobs.
+ * @param machines_num An integer representing the total number of machines.
+ * @param deadlines A vector representing the deadlines for each job.
+ *
+ * @return ObjectFunctionResult The makespan, total tardiness and the start and end
+ * times of the jobs on each machine.
+ */
+ObjectFunctionResult setup_object_function(const std::vector<std::vector<int>> &jobs,
+                                           const SetupTimes &setups,
+                                           const std::vector<int> &order,
+                                           int jobs_num,
+                                           int machines_num,
+                                           const std::vector<int> &deadlines);
+
 /**
  * @brief Calculate the length of the schedule based on job deadlines.
  *
@@ -67,18 +101,16 @@ int deadline_length(const std::vector<std::vector<int>>& jobs,
 /**
  * @brief Print the Gantt chart for a flow-shop scheduling problem.
  *
- * The function takes as input the number of machines, the number of jobs,
- * matrices representing the start and end times of each job on each machine,
- * and prints the Gantt chart for the flow-shop scheduling.
+ * The function takes as input the processing times of jobs, the job order and the
+ * end times of each job on each machine, renders the run-length compressed text
+ * Gantt chart (see render_gantt()) and writes it to the standard output at once.
  *
- * @param machines_num An integer representing the total number of machines.
- * @param jobs_num An integer representing the total number of jobs.
- * @param job_begin A 2D matrix representing the start times of each job on each machine.
+ * @param jobs A 2D vector representing the processing times of jobs on each machine.
+ * @param order A vector specifying the order in which jobs are processed.
  * @param job_end A 2D matrix representing the end times of each job on each machine.
  */
-void print_flow_shop(int machines_num,
-                     int jobs_num,
-                     const std::vector<std::vector<int>>& job_begin,
+void print_flow_shop(const std::vector<std::vector<int>>& jobs,
+                     const std::vector<int>& order,
                      const std::vector<std::vector<int>>& job_end);
 
 #endif // FLOW_SHOP_H
@@ -0,0 +1,202 @@
+#include "gantt.h"
+#include "text_buffer.h"
+#include <algorithm>
+
+static const double SVG_MAX_WIDTH = 1600.0;  // px of the time axis
+static const double SVG_MAX_SCALE = 24.0;    // px per time unit
+static const int SVG_LANE_HEIGHT = 24;
+static const int SVG_LANE_GAP = 6;
+static const int SVG_LEFT = 48;
+static const int SVG_TOP = 12;
+
+static void render_text(std::string &buffer, const std::vector<std::vector<int>> &jobs, const std::vector<int> &order,
+                        const std::vector<std::vector<int>> &job_end) {
+    int machines_num = job_end.size();
+    int jobs_num = order.size();
+    buffer += "\nFLOW-SHOP GANTT CHART:\n\n";
+    for (int i = 0; i < machines_num; ++i) {
+        buffer += 'M';
+        append_int(buffer, i + 1);
+        buffer += " |";
+        int time = 0;
+        for (int j = 0; j < jobs_num; ++j) {
+            int duration = jobs[order[j] - 1][i];
+            int start = job_end[i][j] - duration;
+            if (start > time) {
+                buffer += " -";
+                append_int(buffer, start - time);
+            }
+            buffer += " J";
+            append_int(buffer, order[j]);
+            buffer += ':';
+            append_int(buffer, duration);
+            time = job_end[i][j];
+        }
+        buffer += " |\n";
+    }
+    buffer += '\n';
+}
+
+static void render_csv(std::string &buffer, const std::vector<std::vector<int>> &jobs, const std::vector<int> &order,
+                       const std::vector<std::vector<int>> &job_end) {
+    int machines_num = job_end.size();
+    int jobs_num = order.size();
+    buffer += "machine,job,start,end\n";
+    for (int i = 0; i < machines_num; ++i) {
+        for (int j = 0; j < jobs_num; ++j) {
+            append_int(buffer, i + 1);
+            buffer += ',';
+            append_int(buffer, order[j]);
+            buffer += ',';
+            append_int(buffer, job_end[i][j] - jobs[order[j] - 1][i]);
+            buffer += ',';
+            append_int(buffer, job_end[i][j]);
+            buffer += '\n';
+        }
+    }
+}
+
+// Tick spacing of 1, 2 or 5 times a power of ten giving about ten ticks
+static int tick_step(int makespan) {
+    int step = 1;
+    while (true) {
+        const int factors[] = {1, 2, 5};
+        for (int factor: factors) {
+            if (makespan / (step * factor) <= 10) {
+                return step * factor;
+            }
+        }
+        step *= 10;
+    }
+}
+
+static void render_svg(std::string &buffer, const std::vector<std::vector<int>> &jobs, const std::vector<int> &order,
+                       const std::vector<std::vector<int>> &job_end) {
+    int machines_num = job_end.size();
+    int jobs_num = order.size();
+    int makespan = machines_num > 0 && jobs_num > 0 ? job_end.back().back() : 0;
+    double scale = std::min(SVG_MAX_SCALE, SVG_MAX_WIDTH / std::max(1, makespan));
+    int lanes_bottom = SVG_TOP + machines_num * (SVG_LANE_HEIGHT + SVG_LANE_GAP);
+    int width = SVG_LEFT + static_cast<int>(makespan * scale) + 24;
+    int height = lanes_bottom + 28;
+
+    buffer += "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"";
+    append_int(buffer, width);
+    buffer += "\" height=\"";
+    append_int(buffer, height);
+    buffer += "\" font-family=\"monospace\" font-size=\"10\">\n";
+
+    for (int i = 0; i < machines_num; ++i) {
+        int y = SVG_TOP + i * (SVG_LANE_HEIGHT + SVG_LANE_GAP);
+        buffer += "<text x=\"4\" y=\"";
+        append_int(buffer, y + SVG_LANE_HEIGHT / 2 + 4);
+        buffer += "\">M";
+        append_int(buffer, i + 1);
+        buffer += "</text>\n";
+        for (int j = 0; j < jobs_num; ++j) {
+            int duration = jobs[order[j] - 1][i];
+            double x = SVG_LEFT + (job_end[i][j] - duration) * scale;
+            double w = duration * scale;
+            buffer += "<rect x=\"";
+            append_fixed(buffer, x, 2);
+            buffer += "\" y=\"";
+            append_int(buffer, y);
+            buffer += "\" width=\"";
+            append_fixed(buffer, w, 2);
+            buffer += "\" height=\"";
+            append_int(buffer, SVG_LANE_HEIGHT);
+            // golden-angle hues keep neighboring job numbers apart
+            buffer += "\" fill=\"hsl(";
+            append_int(buffer, order[j] * 137 % 360);
+            buffer += ",65%,70%)\" stroke=\"#333\" stroke-width=\"0.5\"><title>J";
+            append_int(buffer, order[j]);
+            buffer += ' ';
+            append_int(buffer, job_end[i][j] - duration);
+            buffer += '-';
+            append_int(buffer, job_end[i][j]);
+            buffer += "</title></rect>\n";
+            if (w >= 18) {
+                buffer += "<text x=\"";
+                append_fixed(buffer, x + 2, 2);
+                buffer += "\" y=\"";
+                append_int(buffer, y + SVG_LANE_HEIGHT / 2 + 4);
+                buffer += "\">";
+                append_int(buffer, order[j]);
+                buffer += "</text>\n";
+            }
+        }
+    }
+
+    int step = tick_step(makespan);
+    buffer += "<line x1=\"";
+    append_int(buffer, SVG_LEFT);
+    buffer += "\" y1=\"";
+    append_int(buffer, lanes_bottom);
+    buffer += "\" x2=\"";
+    append_fixed(buffer, SVG_LEFT + makespan * scale, 2);
+    buffer += "\" y2=\"";
+    append_int(buffer, lanes_bottom);
+    buffer += "\" stroke=\"#000\"/>\n";
+    for (int tick = 0; tick <= makespan; tick += step) {
+        double x = SVG_LEFT + tick * scale;
+        buffer += "<line x1=\"";
+        append_fixed(buffer, x, 2);
+        buffer += "\" y1=\"";
+        append_int(buffer, lanes_bottom);
+        buffer += "\" x2=\"";
+        append_fixed(buffer, x, 2);
+        buffer += "\" y2=\"";
+        append_int(buffer, lanes_bottom + 4);
+        buffer += "\" stroke=\"#000\"/><text x=\"";
+        append_fixed(buffer, x - 3, 2);
+        buffer += "\" y=\"";
+        append_int(buffer, lanes_bottom + 16);
+        buffer += "\">";
+        append_int(buffer, tick);
+        buffer += "</text>\n";
+    }
+    buffer += "</svg>\n";
+}
+
+void render_gantt(std::string &buffer, GanttFormat format, const std::vector<std::vector<int>> &jobs,
+                  const std::vector<int> &order, const std::vector<std::vector<int>> &job_end) {
+    // rough upper bounds of the bytes per operation, so the buffer grows at most once
+    std::size_t per_operation = format == GanttFormat::svg ? 260 : 24;
+    buffer.reserve(buffer.size() + job_end.size() * order.size() * per_operation + 1024);
+    if (format == GanttFormat::text) {
+        render_text(buffer, jobs, order, job_end);
+    } else if (format == GanttFormat::svg) {
+        render_svg(buffer, jobs, order, job_end);
+    } else {
+        render_csv(buffer, jobs, order, job_end);
+    }
+}
+
+bool write_buffer(std::FILE *file, const std::string &buffer) {
+    return std::fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+}
+
+bool parse_gantt_format(const std::string &name, GanttFormat &format) {
+    if (name == "text") {
+        format = GanttFormat::text;
+    } else if (name == "svg") {
+        format = GanttFormat::svg;
+    } else if (name == "csv") {
+        format = GanttFormat::csv;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string gantt_format_extension(GanttFormat format) {
+    std::string extension;
+    if (format == GanttFormat::text) {
+        extension = "txt";
+    } else if (format == GanttFormat::svg) {
+        extension = "svg";
+    } else if (format == GanttFormat::csv) {
+        extension = "csv";
+    }
+    return extension;
+}
@@ -0,0 +1,68 @@
+#ifndef GANTT_H
+#define GANTT_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Output formats of the Gantt chart renderer.
+ *
+ * - text: One line per machine, run-length compressed: "-3" is three idle time
+ *   units, "J7:5" is job 7 running for five time units.
+ * - svg: A scalable vector graphic with one lane per machine and a scaled time axis.
+ * - csv: One "machine,job,start,end" row per operation.
+ */
+enum class GanttFormat {
+    text,
+    svg,
+    csv
+};
+
+/**
+ * @brief Render the Gantt chart of a schedule into a buffer.
+ *
+ * The start times of the operations are derived from their end times and the
+ * processing times, so the job_begin matrix is not needed. The chart is appended to
+ * the buffer, which is reserved once for the whole chart; no per-segment strings or
+ * stream writes are made. Machines and jobs are numbered from 1.
+ *
+ * @param buffer The buffer the chart is appended to.
+ * @param format The output format.
+ * @param jobs A 2D vector representing the processing times of jobs on each machine.
+ * @param order A vector specifying the order in which jobs are processed.
+ * @param job_end A 2D matrix representing the end times of each job on each machine,
+ * indexed by machine and position.
+ */
+void render_gantt(std::string &buffer,
+                  GanttFormat format,
+                  const std::vector<std::vector<int>> &jobs,
+                  const std::vector<int> &order,
+                  const std::vector<std::vector<int>> &job_end);
+
+/**
+ * @brief Write a buffer to a file with a single write call.
+ *
+ * @param file The file to write to.
+ * @param buffer The data to write.
+ *
+ * @return bool True if the whole buffer was written.
+ */
+bool write_buffer(std::FILE *file, const std::string &buffer);
+
+/**
+ * @brief Parse the name of a Gantt chart format.
+ *
+ * @param name "text", "svg" or "csv".
+ * @param format Output for the parsed format.
+ *
+ * @return bool True if the name is known.
+ */
+bool parse_gantt_format(const std::string &name, GanttFormat &format);
+
+/**
+ * @brief Get the usual file extension of a Gantt chart format, without the dot.
+ */
+std::string gantt_format_extension(GanttFormat format);
+
+#endif // GANTT_H
@@ -0,0 +1,132 @@
+#include "instance.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+static const char INSTANCE_MAGIC[4] = {'F', 'S', 'P', 'I'};
+static const int32_t INSTANCE_VERSION = 1;
+static const int32_t SETUP_INSTANCE_VERSION = 2;
+static const int32_t WEIGHTED_INSTANCE_VERSION = 3;
+
+// The format is little-endian, so int32 arrays are converted only on big-endian hosts
+static bool little_endian() {
+    const uint16_t probe = 1;
+    return *reinterpret_cast<const unsigned char *>(&probe) == 1;
+}
+
+static void swap_bytes(int32_t *values, std::size_t count) {
+    for (std::size_t k = 0; k < count; ++k) {
+        uint32_t v = static_cast<uint32_t>(values[k]);
+        values[k] = static_cast<int32_t>((v >> 24) | ((v >> 8) & 0xFF00) | ((v << 8) & 0xFF0000) | (v << 24));
+    }
+}
+
+static bool write_ints(std::FILE *file, const int *values, std::size_t count) {
+    if (little_endian()) {
+        return std::fwrite(values, sizeof(int32_t), count, file) == count;
+    }
+    std::vector<int32_t> copy(values, values + count);
+    swap_bytes(copy.data(), count);
+    return std::fwrite(copy.data(), sizeof(int32_t), count, file) == count;
+}
+
+static bool read_ints(std::FILE *file, int *values, std::size_t count) {
+    if (std::fread(values, sizeof(int32_t), count, file) != count) {
+        return false;
+    }
+    if (!little_endian()) {
+        swap_bytes(reinterpret_cast<int32_t *>(values), count);
+    }
+    return true;
+}
+
+std::vector<std::vector<int>> jobs_matrix(const Instance &instance) {
+    std::vector<std::vector<int>> jobs(instance.jobs_num, std::vector<int>(instance.machines_num));
+    for (int i = 0; i < instance.machines_num; ++i) {
+        const int *row = &instance.processing[static_cast<std::size_t>(i) * instance.jobs_num];
+        for (int j = 0; j < instance.jobs_num; ++j) {
+            jobs[j][i] = row[j];
+        }
+    }
+    return jobs;
+}
+
+bool validate_instance(const Instance &instance, std::string &error) {
+    std::size_t n = instance.jobs_num;
+    std::size_t m = instance.machines_num;
+    if (instance.jobs_num <= 0 || instance.machines_num <= 0) {
+        error = "the instance needs at least one job and one machine";
+        return false;
+    }
+    if (instance.processing.size() != n * m ||
+        std::any_of(instance.processing.begin(), instance.processing.end(), [](int time) { return time < 0; })) {
+        error = "the instance needs jobs_num * machines_num non-negative processing times";
+        return false;
+    }
+    if ((!instance.deadlines.empty() && instance.deadlines.size() != n) ||
+        (!instance.weights.empty() && instance.weights.size() != n)) {
+        error = "the instance needs one due date, and one weight if any, per job";
+        return false;
+    }
+    if (!instance.setups.empty() && instance.setups.size() != n * n * m) {
+        error = "the setup times of the instance need jobs_num * jobs_num * machines_num entries";
+        return false;
+    }
+    return true;
+}
+
+bool write_instance_binary(std::FILE *file, const Instance &instance) {
+    // every instance is written in the oldest version that holds it, so older readers still load it
+    int version = !instance.weights.empty() ? WEIGHTED_INSTANCE_VERSION
+                  : !instance.setups.empty() ? SETUP_INSTANCE_VERSION : INSTANCE_VERSION;
+    int header[6] = {version, instance.jobs_num, instance.machines_num, !instance.deadlines.empty(),
+                     !instance.setups.empty(), 1};
+    return std::fwrite(INSTANCE_MAGIC, 1, 4, file) == 4 &&
+           write_ints(file, header, version + 3) &&
+           write_ints(file, instance.processing.data(), instance.processing.size()) &&
+           write_ints(file, instance.deadlines.data(), instance.deadlines.size()) &&
+           write_ints(file, instance.setups.data(), instance.setups.size()) &&
+           write_ints(file, instance.weights.data(), instance.weights.size());
+}
+
+bool read_instance_binary(std::FILE *file, Instance &instance) {
+    char magic[4];
+    int header[6] = {0, 0, 0, 0, 0, 0};
+    if (std::fread(magic, 1, 4, file) != 4 || std::memcmp(magic, INSTANCE_MAGIC, 4) != 0 ||
+        !read_ints(file, header, 4) || header[0] < INSTANCE_VERSION || header[0] > WEIGHTED_INSTANCE_VERSION ||
+        header[1] < 0 || header[2] < 0 || !read_ints(file, header + 4, header[0] - INSTANCE_VERSION)) {
+        return false;
+    }
+    instance.jobs_num = header[1];
+    instance.machines_num = header[2];
+    std::size_t n = instance.jobs_num;
+    instance.processing.resize(n * instance.machines_num);
+    instance.deadlines.resize(header[3] ? n : 0);
+    instance.setups.resize(header[4] ? n * n * instance.machines_num : 0);
+    instance.weights.resize(header[5] ? n : 0);
+    return read_ints(file, instance.processing.data(), instance.processing.size()) &&
+           read_ints(file, instance.deadlines.data(), instance.deadlines.size()) &&
+           read_ints(file, instance.setups.data(), instance.setups.size()) &&
+           read_ints(file, instance.weights.data(), instance.weights.size());
+}
+
+bool load_instance(const std::string &path, Instance &instance) {
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool ok = read_instance_binary(file, instance);
+    std::fclose(file);
+    instance.name = path;
+    std::string error;
+    return ok && validate_instance(instance, error);
+}
+
+bool save_instance(const std::string &path, const Instance &instance) {
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool ok = write_instance_binary(file, instance);
+    return std::fclose(file) == 0 && ok;
+}
@@ -0,0 +1,106 @@
+#ifndef INSTANCE_H
+#define INSTANCE_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Struct representing a flow-shop instance in one contiguous buffer.
+ *
+ * The processing times are stored machine-major: the time of job j (0-based) on
+ * machine i is processing[i * jobs_num + j]. This is the layout of the binary
+ * instance format, so an instance is read and written with a single call.
+ *
+ * Optional sequence-dependent setup times form an m x n x n tensor that is stored
+ * with the machine as the fastest index: the setup of machine i between job k and a
+ * directly following job j is setups[(k * jobs_num + j) * machines_num + i]. The
+ * tensor is empty for an instance without setups, see SetupTimes.
+ *
+ * Optional job weights, indexed by job, weight the tardiness of the jobs in the
+ * weighted tardiness objective; they are empty for an unweighted instance.
+ */
+struct Instance {
+    std::string name;
+    int jobs_num;
+    int machines_num;
+    std::vector<int> processing;
+    std::vector<int> deadlines;
+    std::vector<int> setups;
+    std::vector<int> weights;
+};
+
+/**
+ * @brief Convert an instance to the jobs matrix used by the solver.
+ *
+ * @param instance The instance.
+ *
+ * @return std::vector<std::vector<int>> The processing times, indexed by job and machine.
+ */
+std::vector<std::vector<int>> jobs_matrix(const Instance &instance);
+
+/**
+ * @brief Check that the sizes and values of an instance fit together.
+ *
+ * An instance needs at least one job and one machine, jobs_num * machines_num
+ * non-negative processing times, no due dates or one per job, no weights or one per
+ * job, and no setup times or jobs_num * jobs_num * machines_num of them.
+ *
+ * @param instance The instance.
+ * @param error Output for the reason the instance is invalid.
+ *
+ * @return bool True if the instance is valid.
+ */
+bool validate_instance(const Instance &instance, std::string &error);
+
+/**
+ * @brief Write an instance in the binary instance format.
+ *
+ * The format is the magic "FSPI", then little-endian int32 values: the version (1),
+ * jobs_num, machines_num and a flag telling whether deadlines follow, then the
+ * machine-major processing times and, if flagged, the jobs_num deadlines. An
+ * instance with setup times is written as version 2, whose header has a fifth value,
+ * a flag telling whether the n x n x m setup tensor follows the deadlines. An
+ * instance with job weights is written as version 3, whose header has a sixth value,
+ * a flag telling whether the jobs_num weights follow the setups.
+ *
+ * @param file The file to write to.
+ * @param instance The instance.
+ *
+ * @return bool True if the instance was written completely.
+ */
+bool write_instance_binary(std::FILE *file, const Instance &instance);
+
+/**
+ * @brief Read an instance in the binary instance format (version 1, 2 or 3).
+ *
+ * Only the format is checked; the values are checked by validate_instance().
+ *
+ * @param file The file to read from.
+ * @param instance Output for the instance; its name is left unchanged.
+ *
+ * @return bool True if a complete instance was read.
+ */
+bool read_instance_binary(std::FILE *file, Instance &instance);
+
+/**
+ * @brief Read an instance from a binary instance file.
+ *
+ * @param path The path of the file.
+ * @param instance Output for the instance, named after the path.
+ *
+ * @return bool True if an instance was read that passes validate_instance().
+ */
+bool load_instance(const std::string &path, Instance &instance);
+
+/**
+ * @brief Write an instance to a binary instance file.
+ *
+ * @param path The path of the file.
+ * @param instance The instance.
+ *
+ * @return bool True if the instance was written completely.
+ */
+bool save_instance(const std::string &path, const Instance &instance);
+
+#endif // INSTANCE_H
@@ -0,0 +1,185 @@
+#include "instance_generator.h"
+#include "lower_bound.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+
+static const int64_t LEHMER_MULTIPLIER = 16807;
+static const int64_t LEHMER_MODULUS = 2147483647;  // 2^31 - 1
+static const uint64_t DEADLINE_STREAM = 0xD1B54A32D192ED03ULL;
+static const uint64_t SETUP_STREAM = 0x8CB92BA72F3D8DD7ULL;
+static const uint64_t FAMILY_STREAM = 0xA0761D6478BD642FULL;
+static const uint64_t WEIGHT_STREAM = 0xE7037ED1A0B428DBULL;
+
+// Multiplier of the Lehmer generator after k steps, a^k mod (2^31 - 1)
+static int64_t lehmer_jump(uint64_t k) {
+    int64_t result = 1;
+    int64_t base = LEHMER_MULTIPLIER;
+    while (k > 0) {
+        if (k & 1) {
+            result = result * base % LEHMER_MODULUS;
+        }
+        base = base * base % LEHMER_MODULUS;
+        k >>= 1;
+    }
+    return result;
+}
+
+// Taillard's unif(): advances the seed and maps it to [low, high]
+static int taillard_unif(int64_t &seed, int low, int high) {
+    seed = seed * LEHMER_MULTIPLIER % LEHMER_MODULUS;
+    double value = static_cast<double>(seed) / LEHMER_MODULUS;
+    return low + static_cast<int>(value * (high - low + 1));
+}
+
+// Counter-based generator: a well-mixed 64-bit value for every (seed, index) pair
+static uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+static double unit_interval(uint64_t seed, uint64_t index) {
+    return (splitmix64(seed ^ splitmix64(index)) >> 11) * (1.0 / 9007199254740992.0);  // [0, 1)
+}
+
+static void fill_range(int *cells, std::size_t from, std::size_t to, const GeneratorOptions &options) {
+    int low = options.min_time;
+    int high = options.max_time;
+    if (options.distribution == TimeDistribution::taillard) {
+        int64_t seed = static_cast<int64_t>(options.seed % LEHMER_MODULUS);
+        seed = seed * lehmer_jump(from) % LEHMER_MODULUS;
+        for (std::size_t c = from; c < to; ++c) {
+            cells[c] = taillard_unif(seed, low, high);
+        }
+    } else if (options.distribution == TimeDistribution::uniform) {
+        for (std::size_t c = from; c < to; ++c) {
+            cells[c] = low + static_cast<int>(unit_interval(options.seed, c) * (high - low + 1));
+        }
+    } else {
+        double mean = (low + high) / 2.0;
+        for (std::size_t c = from; c < to; ++c) {
+            double value = -mean * std::log(1.0 - unit_interval(options.seed, c));
+            cells[c] = std::max(low, std::min(high, static_cast<int>(std::lround(value))));
+        }
+    }
+}
+
+void generate_due_dates(Instance &instance, const GeneratorOptions &options) {
+    int n = instance.jobs_num;
+    int m = instance.machines_num;
+    std::vector<std::vector<int>> jobs = jobs_matrix(instance);
+    double p = taillard_lower_bound(jobs, n, m).value;
+    double low = p * (1.0 - options.tightness - options.range / 2.0);
+    double high = p * (1.0 - options.tightness + options.range / 2.0);
+    instance.deadlines.resize(n);
+    for (int j = 0; j < n; ++j) {
+        int total = 0;
+        for (int i = 0; i < m; ++i) {
+            total += jobs[j][i];
+        }
+        double due = low + unit_interval(options.seed ^ DEADLINE_STREAM, j) * (high - low);
+        instance.deadlines[j] = std::max(total, static_cast<int>(std::lround(due)));
+    }
+}
+
+void generate_setup_times(Instance &instance, const GeneratorOptions &options) {
+    instance.setups.clear();
+    if (options.setup_max <= 0) {
+        return;
+    }
+    std::size_t n = instance.jobs_num;
+    std::size_t m = instance.machines_num;
+    std::vector<int> family(n);
+    for (std::size_t j = 0; j < n; ++j) {
+        family[j] = options.setup_families > 0
+                    ? static_cast<int>(unit_interval(options.seed ^ FAMILY_STREAM, j) * options.setup_families)
+                    : static_cast<int>(j);
+    }
+    // a setup is drawn per pair of families (of jobs without families), so equal families get equal setups
+    std::size_t groups = options.setup_families > 0 ? options.setup_families : n;
+    instance.setups.assign(n * n * m, 0);
+    for (std::size_t k = 0; k < n; ++k) {
+        for (std::size_t j = 0; j < n; ++j) {
+            if (family[k] == family[j]) {
+                continue;
+            }
+            std::size_t pair = static_cast<std::size_t>(family[k]) * groups + family[j];
+            for (std::size_t i = 0; i < m; ++i) {
+                double value = unit_interval(options.seed ^ SETUP_STREAM, pair * m + i);
+                instance.setups[(k * n + j) * m + i] = 1 + static_cast<int>(value * options.setup_max);
+            }
+        }
+    }
+}
+
+void generate_job_weights(Instance &instance, const GeneratorOptions &options) {
+    instance.weights.clear();
+    if (options.weight_max <= 0) {
+        return;
+    }
+    instance.weights.resize(instance.jobs_num);
+    for (int j = 0; j < instance.jobs_num; ++j) {
+        instance.weights[j] = 1 + static_cast<int>(unit_interval(options.seed ^ WEIGHT_STREAM, j) * options.weight_max);
+    }
+}
+
+Instance generate_instance(int jobs_num, int machines_num, const GeneratorOptions &options) {
+    Instance instance;
+    instance.name = time_distribution_name(options.distribution) + "-" + std::to_string(jobs_num) + "x" +
+                    std::to_string(machines_num) + "-" + std::to_string(options.seed);
+    instance.jobs_num = jobs_num;
+    instance.machines_num = machines_num;
+    std::size_t cells = static_cast<std::size_t>(jobs_num) * machines_num;
+    instance.processing.resize(cells);
+
+    std::size_t workers = std::max(1, std::min<int>(options.threads, cells / 4096 + 1));
+    std::size_t chunk = (cells + workers - 1) / workers;
+    std::vector<std::thread> pool;
+    for (std::size_t w = 1; w < workers; ++w) {
+        std::size_t from = std::min(cells, w * chunk);
+        std::size_t to = std::min(cells, from + chunk);
+        pool.emplace_back(fill_range, instance.processing.data(), from, to, std::cref(options));
+    }
+    fill_range(instance.processing.data(), 0, std::min(cells, chunk), options);
+    for (std::thread &worker: pool) {
+        worker.join();
+    }
+
+    generate_due_dates(instance, options);
+    generate_setup_times(instance, options);
+    generate_job_weights(instance, options);
+    return instance;
+}
+
+bool generate_instance_file(const std::string &path, int jobs_num, int machines_num,
+                            const GeneratorOptions &options) {
+    return save_instance(path, generate_instance(jobs_num, machines_num, options));
+}
+
+bool parse_time_distribution(const std::string &name, TimeDistribution &distribution) {
+    if (name == "taillard") {
+        distribution = TimeDistribution::taillard;
+    } else if (name == "uniform") {
+        distribution = TimeDistribution::uniform;
+    } else if (name == "exponential") {
+        distribution = TimeDistribution::exponential;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string time_distribution_name(TimeDistribution distribution) {
+    std::string name;
+    if (distribution == TimeDistribution::taillard) {
+        name = "taillard";
+    } else if (distribution == TimeDistribution::uniform) {
+        name = "uniform";
+    } else if (distribution == TimeDistribution::exponential) {
+        name = "exponential";
+    }
+    return name;
+}
@@ -0,0 +1,129 @@
+#ifndef INSTANCE_GENERATOR_H
+#define INSTANCE_GENERATOR_H
+
+#include <string>
+#include "instance.h"
+
+/**
+ * @brief Processing-time distributions of the instance generator.
+ *
+ * - taillard: Taillard's generator: a Lehmer generator (multiplier 16807, modulus
+ *   2^31 - 1) drawn machine by machine, uniform on [min_time, max_time]. With the
+ *   time seed of a published instance and the default range 1-99 the instance is
+ *   reproduced exactly.
+ * - uniform: Uniform on [min_time, max_time].
+ * - exponential: Exponential with mean (min_time + max_time) / 2, clamped to [min_time, max_time].
+ */
+enum class TimeDistribution {
+    taillard,
+    uniform,
+    exponential
+};
+
+/**
+ * @brief Struct representing the settings of the instance generator.
+ *
+ * - seed: The seed; every instance is a pure function of the seed and the settings.
+ * - distribution: The processing-time distribution.
+ * - min_time, max_time: The range of the processing times.
+ * - tightness, range: The due-date tightness factor T and range factor R. Deadlines
+ *   are uniform on [P (1 - T - R / 2), P (1 - T + R / 2)], where P is Taillard's
+ *   makespan lower bound, and are at least the job's own total processing time.
+ * - threads: The number of threads filling the processing times. The result does
+ *   not depend on it.
+ * - setup_max: Sequence-dependent setup times are uniform on [1, setup_max], 0
+ *   generates none.
+ * - setup_families: If positive, the jobs are drawn into this many families and the
+ *   setups only depend on the families; jobs of one family need no setup.
+ * - weight_max: Job weights are uniform on [1, weight_max], 0 generates none.
+ */
+struct GeneratorOptions {
+    unsigned long long seed = 1;
+    TimeDistribution distribution = TimeDistribution::taillard;
+    int min_time = 1;
+    int max_time = 99;
+    double tightness = 0.3;
+    double range = 0.6;
+    int threads = 1;
+    int setup_max = 0;
+    int setup_families = 0;
+    int weight_max = 0;
+};
+
+/**
+ * @brief Generate a flow-shop instance.
+ *
+ * The processing times are written into the contiguous, machine-major buffer of the
+ * instance in parallel. Every cell is derived from the seed and its index (the
+ * Taillard generator jumps ahead in its sequence in O(log n)), so the instance is
+ * identical for any number of threads.
+ *
+ * @param jobs_num The total number of jobs.
+ * @param machines_num The total number of machines.
+ * @param options The generator settings, see GeneratorOptions.
+ *
+ * @return Instance The generated instance, named after its settings.
+ */
+Instance generate_instance(int jobs_num, int machines_num, const GeneratorOptions &options);
+
+/**
+ * @brief Generate the deadlines of an instance from its processing times.
+ *
+ * Deadlines are drawn from their own stream of the seed, see GeneratorOptions.
+ *
+ * @param instance The instance; its deadlines are replaced.
+ * @param options The generator settings.
+ */
+void generate_due_dates(Instance &instance, const GeneratorOptions &options);
+
+/**
+ * @brief Generate the sequence-dependent setup times of an instance.
+ *
+ * Setups are drawn from their own stream of the seed, see GeneratorOptions. With
+ * setup_max 0 the setups of the instance are cleared.
+ *
+ * @param instance The instance; its setups are replaced.
+ * @param options The generator settings.
+ */
+void generate_setup_times(Instance &instance, const GeneratorOptions &options);
+
+/**
+ * @brief Generate the job weights of an instance.
+ *
+ * Weights are drawn from their own stream of the seed, see GeneratorOptions. With
+ * weight_max 0 the weights of the instance are cleared.
+ *
+ * @param instance The instance; its weights are replaced.
+ * @param options The generator settings.
+ */
+void generate_job_weights(Instance &instance, const GeneratorOptions &options);
+
+/**
+ * @brief Generate a flow-shop instance straight into a binary instance file.
+ *
+ * @param path The path of the file.
+ * @param jobs_num The total number of jobs.
+ * @param machines_num The total number of machines.
+ * @param options The generator settings, see GeneratorOptions.
+ *
+ * @return bool True if the file was written completely.
+ */
+bool generate_instance_file(const std::string &path, int jobs_num, int machines_num,
+                            const GeneratorOptions &options);
+
+/**
+ * @brief Parse the name of a processing-time distribution.
+ *
+ * @param name "taillard", "uniform" or "exponential".
+ * @param distribution Output for the parsed distribution.
+ *
+ * @return bool True if the name is known.
+ */
+bool parse_time_distribution(const std::string &name, TimeDistribution &distribution);
+
+/**
+ * @brief Get the name of a processing-time distribution.
+ */
+std::string time_distribution_name(TimeDistribution distribution);
+
+#endif // INSTANCE_GENERATOR_H
@@ -0,0 +1,54 @@
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "instance.h"
+
+static int failures = 0;
+
+static void check(bool condition, const std::string &what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        ++failures;
+    }
+}
+
+// Writes the magic and the given int32 values in host order, which is the file order on little-endian hosts
+static void write_file(const std::string &path, const std::vector<int32_t> &values, bool magic = true) {
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    if (magic) {
+        std::fwrite("FSPI", 1, 4, file);
+    }
+    std::fwrite(values.data(), sizeof(int32_t), values.size(), file);
+    std::fclose(file);
+}
+
+int main() {
+    const std::string path = "instance_test.fspi";
+    Instance instance;
+
+    write_file(path, {}, false);
+    check(!load_instance(path, instance), "an empty file is rejected");
+
+    write_file(path, {1, 2, 1, 0, 4});
+    check(!load_instance(path, instance), "a truncated file is rejected");
+
+    write_file(path, {1, 0, 3, 0});
+    check(!load_instance(path, instance), "an instance without jobs is rejected");
+
+    write_file(path, {1, 2, 1, 0, 4, -1});
+    check(!load_instance(path, instance), "a negative processing time is rejected");
+
+    write_file(path, {1, 2, 1, 1, 4, 5, 7, 9});
+    check(load_instance(path, instance) && instance.jobs_num == 2 && instance.machines_num == 1 &&
+          instance.deadlines.size() == 2, "a valid instance is read");
+
+    Instance written = instance;
+    written.weights = {1, 3};
+    check(save_instance(path, written) && load_instance(path, instance) && instance.weights == written.weights &&
+          instance.processing == written.processing, "a saved instance is read back");
+
+    std::remove(path.c_str());
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,339 @@
+#include "island_model.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define ISLANDS_FORK 1
+#endif
+
+// The rings are shared between processes, which is only safe with address-free atomics
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2, "lock-free atomics are required");
+
+static const std::size_t CACHE_LINE = 64;
+
+static std::size_t align_up(std::size_t size) {
+    return (size + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+}
+
+struct RingHeader {
+    std::atomic<unsigned long long> head;
+    char head_padding[CACHE_LINE - sizeof(std::atomic<unsigned long long>)];
+    std::atomic<unsigned long long> tail;
+    char tail_padding[CACHE_LINE - sizeof(std::atomic<unsigned long long>)];
+};
+
+struct SlotHeader {
+    std::atomic<unsigned long long> sequence;
+    int32_t value;
+    int32_t source;
+};
+
+struct ReportHeader {
+    std::atomic<int> done;
+    int32_t value;
+    int64_t evaluations;
+    int64_t sent;
+    int64_t accepted;
+};
+
+// A bounded multi-producer ring of fixed-size slots, each holding one order. Every
+// slot carries a sequence number that tells producers and the consumer whose turn it is.
+class MigrantRing {
+public:
+    MigrantRing(char *memory, std::size_t slots, std::size_t slot_stride, int jobs_num)
+            : header_(reinterpret_cast<RingHeader *>(memory)), slots_(memory + sizeof(RingHeader)),
+              mask_(slots - 1), stride_(slot_stride), jobs_num_(jobs_num) {
+    }
+
+    void initialize() {
+        new(&header_->head) std::atomic<unsigned long long>(0);
+        new(&header_->tail) std::atomic<unsigned long long>(0);
+        for (std::size_t k = 0; k <= mask_; ++k) {
+            new(&slot(k)->sequence) std::atomic<unsigned long long>(k);
+        }
+    }
+
+    // Returns false if the ring is full
+    bool push(const std::vector<int> &order, int value, int source) {
+        unsigned long long position = header_->tail.load(std::memory_order_relaxed);
+        SlotHeader *target;
+        while (true) {
+            target = slot(position & mask_);
+            unsigned long long sequence = target->sequence.load(std::memory_order_acquire);
+            long long difference = static_cast<long long>(sequence - position);
+            if (difference == 0) {
+                if (header_->tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = header_->tail.load(std::memory_order_relaxed);
+            }
+        }
+        target->value = value;
+        target->source = source;
+        std::memcpy(reinterpret_cast<char *>(target) + sizeof(*target), order.data(), jobs_num_ * sizeof(int32_t));
+        target->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Returns false if the ring is empty; only the owning island pops
+    bool pop(std::vector<int> &order, int &value) {
+        unsigned long long position = header_->head.load(std::memory_order_relaxed);
+        SlotHeader *source = slot(position & mask_);
+        if (source->sequence.load(std::memory_order_acquire) != position + 1) {
+            return false;
+        }
+        value = source->value;
+        order.resize(jobs_num_);
+        std::memcpy(order.data(), reinterpret_cast<const char *>(source) + sizeof(*source),
+                    jobs_num_ * sizeof(int32_t));
+        header_->head.store(position + 1, std::memory_order_relaxed);
+        source->sequence.store(position + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    SlotHeader *slot(std::size_t index) const {
+        return reinterpret_cast<SlotHeader *>(slots_ + index * stride_);
+    }
+
+    RingHeader *header_;
+    char *slots_;
+    std::size_t mask_;
+    std::size_t stride_;
+    int jobs_num_;
+};
+
+// Layout of the segment: one ring per island, then one report per island
+struct SegmentLayout {
+    std::size_t slots;
+    std::size_t slot_stride;
+    std::size_t ring_stride;
+    std::size_t report_stride;
+    std::size_t size;
+
+    SegmentLayout(int islands, int jobs_num, int slot_count) {
+        slots = 1;
+        while (slots < static_cast<std::size_t>(std::max(1, slot_count))) {
+            slots <<= 1;
+        }
+        slot_stride = align_up(sizeof(SlotHeader) + jobs_num * sizeof(int32_t));
+        ring_stride = sizeof(RingHeader) + slots * slot_stride;
+        report_stride = align_up(sizeof(ReportHeader) + jobs_num * sizeof(int32_t));
+        size = islands * (ring_stride + report_stride);
+    }
+};
+
+static std::vector<int> island_targets(int island, int islands, MigrationTopology topology, std::mt19937 &rng) {
+    std::vector<int> targets;
+    if (islands < 2) {
+        return targets;
+    }
+    if (topology == MigrationTopology::ring) {
+        targets.push_back((island + 1) % islands);
+    } else if (topology == MigrationTopology::broadcast) {
+        for (int k = 0; k < islands; ++k) {
+            if (k != island) {
+                targets.push_back(k);
+            }
+        }
+    } else {
+        int target = std::uniform_int_distribution<int>(0, islands - 2)(rng);
+        targets.push_back(target >= island ? target + 1 : target);
+    }
+    return targets;
+}
+
+static std::vector<int> anneal_island(Objective objective, const std::vector<std::vector<int>> &jobs,
+                                      const std::vector<int> &s, ObjectFunction object_f, int iterations,
+                                      int neighbors, int t0, int jobs_num, int machines_num, int cooling_strategy,
+                                      const std::vector<int> &deadlines, const AnnealingOptions &options,
+                                      AnnealingStats &stats) {
+    std::vector<int> order = simulated_annealing(objective, jobs, s, object_f, iterations, neighbors, t0, jobs_num,
+                                                 machines_num, cooling_strategy, deadlines, options, &stats);
+    if (!stats.overflow.empty()) {
+        stats.best_value = INT_MAX;  // an island that overflowed never has the best order
+    }
+    return order;
+}
+
+IslandResult run_islands(Objective objective, const std::vector<std::vector<int>> &jobs, const std::vector<int> &s,
+                         ObjectFunction object_f, int iterations, int neighbors, int t0, int jobs_num,
+                         int machines_num, int cooling_strategy, const std::vector<int> &deadlines,
+                         const AnnealingOptions &options, const IslandOptions &island_options) {
+    int cores = std::max(1u, std::thread::hardware_concurrency());
+    int islands = island_options.islands > 0 ? island_options.islands : cores;
+    unsigned base_seed = options.seed != 0 ? options.seed : std::random_device()();
+    IslandResult result;
+    result.islands = islands;
+
+#if defined(ISLANDS_FORK)
+    SegmentLayout layout(islands, jobs_num, island_options.slots);
+    // The segment is unlinked right after mapping: the forked islands inherit the
+    // mapping, and nothing is left behind in /dev/shm if the launcher dies
+    std::string name = "/flow-shop-islands-" + std::to_string(getpid());
+    int descriptor = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (descriptor < 0) {
+        std::cerr << "Could not create the shared memory segment " << name << std::endl;
+        islands = 0;
+    }
+    void *mapping = MAP_FAILED;
+    if (descriptor >= 0) {
+        shm_unlink(name.c_str());
+        if (ftruncate(descriptor, layout.size) == 0) {
+            mapping = mmap(nullptr, layout.size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+        }
+        close(descriptor);
+        if (mapping == MAP_FAILED) {
+            std::cerr << "Could not map the shared memory segment" << std::endl;
+            islands = 0;
+        }
+    }
+    char *segment = mapping != MAP_FAILED ? static_cast<char *>(mapping) : nullptr;
+    char *reports = segment + islands * layout.ring_stride;
+    std::vector<MigrantRing> rings;
+    for (int k = 0; k < islands; ++k) {
+        rings.emplace_back(segment + k * layout.ring_stride, layout.slots, layout.slot_stride, jobs_num);
+        rings.back().initialize();
+        new(&reinterpret_cast<ReportHeader *>(reports + k * layout.report_stride)->done) std::atomic<int>(0);
+    }
+
+    // Buffered output would be written once more by every island
+    std::cout.flush();
+    std::fflush(nullptr);
+    std::vector<pid_t> workers;
+    for (int island = 0; island < islands; ++island) {
+        pid_t pid = fork();
+        if (pid < 0) {
+            std::cerr << "Could not start island " << island << std::endl;
+            break;
+        }
+        if (pid > 0) {
+            workers.push_back(pid);
+            continue;
+        }
+#if defined(__linux__)
+        if (island_options.pin_cores) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(island % cores, &cpus);
+            sched_setaffinity(0, sizeof(cpus), &cpus);
+        }
+#endif
+        AnnealingOptions island_annealing = options;
+        island_annealing.seed = (base_seed + island) != 0 ? base_seed + island : 1;
+        island_annealing.shared_cache = nullptr;
+        std::mt19937 rng(island_annealing.seed);
+        std::vector<int> migrant;
+        long long sent = 0, accepted = 0;
+        int interval = std::max(1, island_options.migration_interval);
+        island_annealing.on_epoch = [&](int epoch, const std::vector<int> &best, int best_value,
+                                        std::vector<int> &current, int &current_value) {
+            if ((epoch + 1) % interval != 0) {
+                return false;
+            }
+            for (int target: island_targets(island, islands, island_options.topology, rng)) {
+                sent += rings[target].push(best, best_value, island);
+            }
+            bool replaced = false;
+            int migrant_value;
+            while (rings[island].pop(migrant, migrant_value)) {
+                if (migrant_value < current_value) {
+                    current.swap(migrant);
+                    current_value = migrant_value;
+                    replaced = true;
+                }
+            }
+            accepted += replaced;
+            return replaced;
+        };
+        AnnealingStats stats;
+        std::vector<int> order = anneal_island(objective, jobs, s, object_f, iterations, neighbors, t0, jobs_num,
+                                               machines_num, cooling_strategy, deadlines, island_annealing, stats);
+        char *slot = reports + island * layout.report_stride;
+        ReportHeader *report = reinterpret_cast<ReportHeader *>(slot);
+        report->value = stats.best_value;
+        report->evaluations = stats.evaluations;
+        report->sent = sent;
+        report->accepted = accepted;
+        std::memcpy(slot + sizeof(ReportHeader), order.data(), jobs_num * sizeof(int32_t));
+        report->done.store(1, std::memory_order_release);
+        _exit(0);
+    }
+
+    for (std::size_t island = 0; island < workers.size(); ++island) {
+        int status = 0;
+        waitpid(workers[island], &status, 0);
+        char *slot = reports + island * layout.report_stride;
+        const ReportHeader *report = reinterpret_cast<const ReportHeader *>(slot);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || report->done.load(std::memory_order_acquire) != 1) {
+            ++result.failed_islands;
+            continue;
+        }
+        result.evaluations += report->evaluations;
+        result.migrants_sent += report->sent;
+        result.migrants_accepted += report->accepted;
+        if (result.best_island < 0 || report->value < result.value) {
+            const int32_t *order = reinterpret_cast<const int32_t *>(slot + sizeof(ReportHeader));
+            result.order.assign(order, order + jobs_num);
+            result.value = report->value;
+            result.best_island = island;
+        }
+    }
+    result.failed_islands = result.islands - static_cast<int>(workers.size()) + result.failed_islands;
+    if (mapping != MAP_FAILED) {
+        munmap(mapping, layout.size);
+    }
+#else
+    for (int island = 0; island < islands; ++island) {
+        AnnealingOptions island_annealing = options;
+        island_annealing.seed = (base_seed + island) != 0 ? base_seed + island : 1;
+        island_annealing.on_epoch = nullptr;
+        AnnealingStats stats;
+        std::vector<int> order = anneal_island(objective, jobs, s, object_f, iterations, neighbors, t0, jobs_num,
+                                               machines_num, cooling_strategy, deadlines, island_annealing, stats);
+        result.evaluations += stats.evaluations;
+        if (result.best_island < 0 || stats.best_value < result.value) {
+            result.order = order;
+            result.value = stats.best_value;
+            result.best_island = island;
+        }
+    }
+#endif
+    if (result.best_island < 0) {
+        ObjectiveContext context;
+        context.setups = options.setups;
+        context.job_weights = options.job_weights;
+        context.combination = options.combination;
+        std::vector<int> state;
+        result.order = s;
+        result.value = evaluate_order(jobs, machines_num, deadlines, objective, &context, s, state);
+    }
+    return result;
+}
+
+bool parse_migration_topology(const std::string &name, MigrationTopology &topology) {
+    if (name == "ring") {
+        topology = MigrationTopology::ring;
+    } else if (name == "broadcast") {
+        topology = MigrationTopology::broadcast;
+    } else if (name == "random") {
+        topology = MigrationTopology::random;
+    } else {
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,120 @@
+#ifndef ISLAND_MODEL_H
+#define ISLAND_MODEL_H
+
+#include <string>
+#include <vector>
+#include "simulated_annealing.h"
+#include "sequence_evaluator.h"
+
+/**
+ * @brief Migration topologies of the island model.
+ *
+ * - ring: Island k sends its best order to island k + 1.
+ * - broadcast: Every island sends its best order to all other islands.
+ * - random: Every island sends its best order to one other island picked at random.
+ */
+enum class MigrationTopology {
+    ring,
+    broadcast,
+    random
+};
+
+/**
+ * @brief Struct representing the settings of the island model.
+ *
+ * - islands: The number of worker processes, 0 starts one per hardware thread.
+ * - migration_interval: The number of epochs between two migrations.
+ * - topology: Where the migrants are sent, see MigrationTopology.
+ * - slots: The capacity of the migrant ring of every island, rounded up to a power
+ *   of two. Migrants sent to a full ring are dropped.
+ * - pin_cores: If true, island k is pinned to core k modulo the number of cores (Linux).
+ */
+struct IslandOptions {
+    int islands = 0;
+    int migration_interval = 10;
+    MigrationTopology topology = MigrationTopology::ring;
+    int slots = 8;
+    bool pin_cores = true;
+};
+
+/**
+ * @brief Struct representing the outcome of an island model run.
+ *
+ * - order: The best job order of all islands.
+ * - value: Its objective value.
+ * - best_island: The island that found it, -1 if no island finished.
+ * - islands: The number of islands started.
+ * - failed_islands: The number of islands that crashed or exited without a result.
+ * - evaluations: The neighbors evaluated by all finished islands.
+ * - migrants_sent: The migrants pushed into a ring by all finished islands.
+ * - migrants_accepted: The migrants that replaced the current order of an island.
+ */
+struct IslandResult {
+    std::vector<int> order;
+    int value = 0;
+    int best_island = -1;
+    int islands = 0;
+    int failed_islands = 0;
+    long long evaluations = 0;
+    long long migrants_sent = 0;
+    long long migrants_accepted = 0;
+};
+
+/**
+ * @brief Run simulated annealing as an island model of forked worker processes.
+ *
+ * Every island is a separate process running the annealing engine from the same
+ * initial order with its own seed (options.seed + k, or random seeds if it is 0),
+ * so islands share no allocator or cache lines and a crashing island does not take
+ * down the others. The islands exchange their best orders through an anonymous
+ * POSIX shared-memory segment that holds one lock-free ring of fixed-size slots per
+ * island. Every migration_interval epochs an island sends its best order along the
+ * topology, drains its own ring and continues from the best migrant if it beats its
+ * current order. At the end every island writes its result into its report slot of
+ * the segment and the launcher collects the global best.
+ *
+ * On systems without fork() the islands run one after another in this process,
+ * without migration.
+ *
+ * @param objective The objective to minimize.
+ * @param jobs A 2D vector representing the processing times of jobs on each machine.
+ * @param s An initial job order.
+ * @param object_f A function to calculate the objective function result of an order.
+ * @param iterations The number of iterations of every island.
+ * @param neighbors The number of neighbors considered at each iteration.
+ * @param t0 Initial temperature.
+ * @param jobs_num The total number of jobs.
+ * @param machines_num The total number of machines.
+ * @param cooling_strategy An integer representing the chosen cooling strategy.
+ * @param deadlines A vector representing the deadlines for each job.
+ * @param options The settings of the engine on every island. shared_cache and
+ * on_epoch are replaced by the island model.
+ * @param island_options The settings of the island model, see IslandOptions.
+ *
+ * @return IslandResult The global best and the statistics of the run.
+ */
+IslandResult run_islands(Objective objective,
+                         const std::vector<std::vector<int>> &jobs,
+                         const std::vector<int> &s,
+                         ObjectFunction object_f,
+                         int iterations,
+                         int neighbors,
+                         int t0,
+                         int jobs_num,
+                         int machines_num,
+                         int cooling_strategy,
+                         const std::vector<int> &deadlines,
+                         const AnnealingOptions &options,
+                         const IslandOptions &island_options);
+
+/**
+ * @brief Parse the name of a migration topology.
+ *
+ * @param name "ring", "broadcast" or "random".
+ * @param topology Output for the parsed topology.
+ *
+ * @return bool True if the name is known.
+ */
+bool parse_migration_topology(const std::string &name, MigrationTopology &topology);
+
+#endif // ISLAND_MODEL_H
@@ -0,0 +1,252 @@
+#include "local_search.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include "no_wait.h"
+
+struct Insertion {
+    int position;
+    int value;
+};
+
+// Best position of a job in a partial order and the objective value after inserting it there
+static Insertion best_insertion(const std::vector<std::vector<int>> &jobs, int machines_num,
+                                const std::vector<int> &deadlines, Objective objective,
+                                const ObjectiveContext *context, const std::vector<int> &partial, int job,
+                                std::mt19937 &rng, PolishWorkspace &workspace) {
+    bool setups = context != nullptr && context->setups != nullptr;
+    if (objective == Objective::c_max && !setups) {
+        InsertionResult result = taillard_insertion(jobs, machines_num, partial, job, NehTieBreaking::first, rng, 1,
+                                                    workspace.taillard);
+        return {result.position, result.c_max};
+    }
+    int k = partial.size();
+    if (objective == Objective::no_wait_c_max) {
+        // only the links around the inserted job change, each costs O(m)
+        int length = std::accumulate(jobs[job - 1].begin(), jobs[job - 1].begin() + machines_num, 0);
+        if (k == 0) {
+            return {0, length};
+        }
+        int base = checked_value(no_wait_makespan(jobs, machines_num, partial));
+        Insertion best = {0, base + no_wait_delay(jobs, machines_num, job, partial[0])};
+        for (int pos = 1; pos < k; ++pos) {
+            int value = base + no_wait_delay(jobs, machines_num, partial[pos - 1], job) +
+                        no_wait_delay(jobs, machines_num, job, partial[pos]) -
+                        no_wait_delay(jobs, machines_num, partial[pos - 1], partial[pos]);
+            if (value < best.value) {
+                best = {pos, value};
+            }
+        }
+        const std::vector<int> &last_job = jobs[partial[k - 1] - 1];
+        int last = std::accumulate(last_job.begin(), last_job.begin() + machines_num, 0);
+        int value = base - last + no_wait_delay(jobs, machines_num, partial[k - 1], job) + length;
+        if (value < best.value) {
+            best = {k, value};
+        }
+        return best;
+    }
+    // setups and the due-date criteria have no head and tail decomposition, every position is evaluated in full
+    auto value_of = [&](const std::vector<int> &candidate) {
+        if (objective == Objective::t_sum && !setups) {
+            return total_tardiness(jobs, machines_num, candidate, deadlines, workspace.tardiness);
+        }
+        return evaluate_order(jobs, machines_num, deadlines, objective, context, candidate, workspace.state);
+    };
+    std::vector<int> &candidate = workspace.candidate;
+    candidate.assign(1, job);
+    candidate.insert(candidate.end(), partial.begin(), partial.end());
+    Insertion best = {0, value_of(candidate)};
+    for (int pos = 1; pos <= k; ++pos) {
+        std::swap(candidate[pos - 1], candidate[pos]);
+        int value = value_of(candidate);
+        if (value < best.value) {
+            best = {pos, value};
+        }
+    }
+    return best;
+}
+
+int insertion_local_search(const std::vector<std::vector<int>> &jobs, int machines_num,
+                           const std::vector<int> &deadlines, Objective objective,
+                           const ObjectiveContext *context, std::vector<int> &order, int value,
+                           PolishWorkspace &workspace, const std::atomic<bool> *stop) {
+    int n = order.size();
+    if (n < 2) {
+        return value;
+    }
+    std::mt19937 rng;  // the first-position tie-breaking draws no numbers
+    const std::vector<int> reference = order;
+    std::vector<int> &partial = workspace.partial;
+    for (int k = 0, unimproved = 0; unimproved < n; k = (k + 1) % n) {
+        if (k == 0 && stop != nullptr && *stop) {
+            break;
+        }
+        int job = reference[k];
+        int position = std::find(order.begin(), order.end(), job) - order.begin();
+        partial = order;
+        partial.erase(partial.begin() + position);
+        Insertion best = best_insertion(jobs, machines_num, deadlines, objective, context, partial, job, rng,
+                                        workspace);
+        if (best.value < value) {
+            partial.insert(partial.begin() + best.position, job);
+            order.swap(partial);
+            value = best.value;
+            unimproved = 0;
+        } else {
+            ++unimproved;
+        }
+    }
+    return value;
+}
+
+int iterated_greedy(const std::vector<std::vector<int>> &jobs, int machines_num, const std::vector<int> &deadlines,
+                    Objective objective, const ObjectiveContext *context, std::vector<int> &order, int value,
+                    const PolishOptions &options, std::mt19937 &rng, PolishWorkspace &workspace,
+                    const std::atomic<bool> *stop) {
+    value = insertion_local_search(jobs, machines_num, deadlines, objective, context, order, value, workspace,
+                                   stop);
+    int n = order.size();
+    int destruction = std::min(options.destruction, n - 1);
+    std::vector<int> current = order;
+    int current_value = value;
+    std::vector<int> candidate;
+    std::vector<int> removed;
+    for (int k = 0; k < options.greedy_iterations && destruction > 0 && !(stop != nullptr && *stop); ++k) {
+        candidate = current;
+        removed.clear();
+        for (int r = 0; r < destruction; ++r) {
+            int position = std::uniform_int_distribution<int>(0, candidate.size() - 1)(rng);
+            removed.push_back(candidate[position]);
+            candidate.erase(candidate.begin() + position);
+        }
+        int candidate_value = 0;
+        for (int job: removed) {
+            Insertion best = best_insertion(jobs, machines_num, deadlines, objective, context, candidate, job, rng,
+                                            workspace);
+            candidate.insert(candidate.begin() + best.position, job);
+            candidate_value = best.value;
+        }
+        candidate_value = insertion_local_search(jobs, machines_num, deadlines, objective, context, candidate,
+                                                 candidate_value, workspace, stop);
+        // accepting ties lets the search drift across plateaus
+        if (candidate_value <= current_value) {
+            current.swap(candidate);
+            current_value = candidate_value;
+            if (current_value < value) {
+                order = current;
+                value = current_value;
+            }
+        }
+    }
+    return value;
+}
+
+Polisher::Polisher(const std::vector<std::vector<int>> &jobs, int machines_num, const std::vector<int> &deadlines,
+                   Objective objective, const ObjectiveContext *context, const PolishOptions &options)
+        : jobs_(jobs), machines_num_(machines_num), deadlines_(deadlines), objective_(objective),
+          context_(context != nullptr ? *context : ObjectiveContext()), options_(options), stop_(false) {
+    thread_ = std::thread(&Polisher::run, this);
+}
+
+Polisher::~Polisher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    changed_.notify_all();
+    thread_.join();
+}
+
+void Polisher::submit(const std::vector<int> &order, int value) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_ = order;
+        pending_value_ = value;
+        has_pending_ = true;
+    }
+    changed_.notify_all();
+}
+
+bool Polisher::take(std::vector<int> &order, int &value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!has_result_) {
+        return false;
+    }
+    order.swap(result_);
+    value = result_value_;
+    has_result_ = false;
+    return true;
+}
+
+void Polisher::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this] { return stop_ || (!has_pending_ && !busy_); });
+}
+
+int Polisher::runs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return runs_;
+}
+
+int Polisher::improvements() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return improvements_;
+}
+
+void Polisher::run() {
+    std::mt19937 rng(options_.seed);
+    PolishWorkspace workspace;
+    std::vector<int> order;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        changed_.wait(lock, [this] { return stop_ || has_pending_; });
+        if (stop_) {
+            return;
+        }
+        order.swap(pending_);
+        int start = pending_value_;
+        has_pending_ = false;
+        busy_ = true;
+        lock.unlock();
+        int value = start;
+        bool overflow = false;
+        // an exception must not leave the thread; an order whose value overflows is dropped
+        // and polishing stops, since the orders it would go on to build overflow just as well
+        try {
+            value = iterated_greedy(jobs_, machines_num_, deadlines_, objective_, &context_, order, start, options_,
+                                    rng, workspace, &stop_);
+        } catch (std::overflow_error &) {
+            overflow = true;
+        }
+        lock.lock();
+        busy_ = false;
+        if (overflow) {
+            stop_ = true;
+            changed_.notify_all();
+            return;
+        }
+        ++runs_;
+        if (value < start) {
+            ++improvements_;
+            if (!has_result_ || value < result_value_) {
+                result_ = order;
+                result_value_ = value;
+                has_result_ = true;
+            }
+        }
+        changed_.notify_all();
+    }
+}
+
+bool parse_polish_mode(const std::string &name, PolishMode &mode) {
+    if (name == "off") {
+        mode = PolishMode::off;
+    } else if (name == "best") {
+        mode = PolishMode::best;
+    } else if (name == "periodic") {
+        mode = PolishMode::periodic;
+    } else {
+        return false;
+    }
+    return true;
+}
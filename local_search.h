@@ -0,0 +1,211 @@
+#ifndef LOCAL_SEARCH_H
+#define LOCAL_SEARCH_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "neh.h"
+#include "setup_times.h"
+#include "sequence_evaluator.h"
+#include "tardiness_seeds.h"
+
+/**
+ * @brief When the annealing engine hands its search to the polisher.
+ *
+ * - off: Never polish.
+ * - best: Polish every new global best order.
+ * - periodic: Polish the current order every interval epochs.
+ */
+enum class PolishMode {
+    off,
+    best,
+    periodic
+};
+
+/**
+ * @brief Struct representing the settings of the polishing stage.
+ *
+ * - mode: When orders are polished, see PolishMode.
+ * - interval: The number of epochs between two periodic polishes.
+ * - destruction: The number of jobs an iterated greedy iteration removes and reinserts.
+ * - greedy_iterations: The number of iterated greedy iterations of one polish, 0 only
+ *   runs the insertion local search.
+ * - seed: The seed of the destruction steps.
+ */
+struct PolishOptions {
+    PolishMode mode = PolishMode::off;
+    int interval = 50;
+    int destruction = 4;
+    int greedy_iterations = 20;
+    unsigned seed = 1;
+};
+
+/**
+ * @brief Struct holding the scratch buffers of the polishing stage.
+ */
+struct PolishWorkspace {
+    TaillardWorkspace taillard;
+    TardinessWorkspace tardiness;
+    std::vector<int> partial;
+    std::vector<int> candidate;
+    std::vector<int> state;
+};
+
+/**
+ * @brief Improve a job order with the RZ insertion local search.
+ *
+ * The jobs are taken in the order they have at the start. Each job is removed and
+ * reinserted at its best position, which is kept when it improves the order; the
+ * search stops after a full round of jobs without improvement. For the makespan the
+ * positions are evaluated with taillard_insertion() and for the no-wait makespan
+ * from the delays around the job, so one job costs O(n * m) for both. With setup
+ * times and for the other objectives every position is evaluated in full by
+ * evaluate_order().
+ *
+ * @param jobs A 2D vector representing the processing times of jobs on each machine.
+ * @param machines_num The total number of machines.
+ * @param deadlines A vector representing the deadlines for each job.
+ * @param objective The objective to minimize.
+ * @param context Optional setups, job weights and combination, may be nullptr.
+ * @param order The job order (1-based job numbers), improved in place.
+ * @param value The objective value of the order.
+ * @param workspace Scratch buffers reused between calls.
+ * @param stop Optional flag polled before every round of jobs, the search ends when it is set.
+ *
+ * @return int The objective value of the improved order.
+ */
+int insertion_local_search(const std::vector<std::vector<int>> &jobs,
+                           int machines_num,
+                           const std::vector<int> &deadlines,
+                           Objective objective,
+                           const ObjectiveContext *context,
+                           std::vector<int> &order,
+                           int value,
+                           PolishWorkspace &workspace,
+                           const std::atomic<bool> *stop = nullptr);
+
+/**
+ * @brief Improve a job order with iterated greedy (Ruiz and Stuetzle).
+ *
+ * Every iteration removes options.destruction random jobs, reinserts them one by one
+ * at their best position and runs insertion_local_search() on the result, which
+ * replaces the current order when it is not worse. The start order is polished by
+ * the local search first.
+ *
+ * @param jobs A 2D vector representing the processing times of jobs on each machine.
+ * @param machines_num The total number of machines.
+ * @param deadlines A vector representing the deadlines for each job.
+ * @param objective The objective to minimize.
+ * @param context Optional setups, job weights and combination, may be nullptr.
+ * @param order The job order (1-based job numbers), replaced by the best order found.
+ * @param value The objective value of the order.
+ * @param options The destruction size and iteration count, see PolishOptions.
+ * @param rng The random generator of the destruction steps.
+ * @param workspace Scratch buffers reused between calls.
+ * @param stop Optional flag polled between iterations and by the local search, the search
+ * ends when it is set.
+ *
+ * @return int The objective value of the best order found.
+ */
+int iterated_greedy(const std::vector<std::vector<int>> &jobs,
+                    int machines_num,
+                    const std::vector<int> &deadlines,
+                    Objective objective,
+                    const ObjectiveContext *context,
+                    std::vector<int> &order,
+                    int value,
+                    const PolishOptions &options,
+                    std::mt19937 &rng,
+                    PolishWorkspace &workspace,
+                    const std::atomic<bool> *stop = nullptr);
+
+/**
+ * @brief Background thread polishing the orders handed over by an annealing run.
+ *
+ * submit() never blocks: an order submitted while another one is being polished
+ * replaces the one still waiting. take() returns a polished order once it is
+ * better than the order it was polished from. Which orders are polished and when
+ * their results come back depends on the timing of the threads, so a run with a
+ * polisher is not reproducible from its seed. If an objective value overflows while
+ * polishing, the order is dropped and the thread stops polishing.
+ */
+class Polisher {
+public:
+    /**
+     * @brief Start the polishing thread. The instance and the setups of the context
+     * must outlive the polisher; the rest of the context is copied.
+     */
+    Polisher(const std::vector<std::vector<int>> &jobs,
+             int machines_num,
+             const std::vector<int> &deadlines,
+             Objective objective,
+             const ObjectiveContext *context,
+             const PolishOptions &options);
+
+    /**
+     * @brief Stop the polishing thread, abandoning the order being polished.
+     */
+    ~Polisher();
+
+    Polisher(const Polisher &) = delete;
+    Polisher &operator=(const Polisher &) = delete;
+
+    /**
+     * @brief Hand an order and its objective value over to the thread.
+     */
+    void submit(const std::vector<int> &order, int value);
+
+    /**
+     * @brief Take the last polished order if it improved on its start order.
+     *
+     * @return bool True if order and value were replaced.
+     */
+    bool take(std::vector<int> &order, int &value);
+
+    /**
+     * @brief Block until the thread has polished every submitted order.
+     */
+    void wait();
+
+    int runs() const;
+    int improvements() const;
+
+private:
+    void run();
+
+    const std::vector<std::vector<int>> &jobs_;
+    int machines_num_;
+    const std::vector<int> &deadlines_;
+    Objective objective_;
+    ObjectiveContext context_;
+    PolishOptions options_;
+    mutable std::mutex mutex_;
+    std::condition_variable changed_;
+    std::vector<int> pending_;
+    int pending_value_ = 0;
+    bool has_pending_ = false;
+    bool busy_ = false;
+    std::vector<int> result_;
+    int result_value_ = 0;
+    bool has_result_ = false;
+    std::atomic<bool> stop_;
+    int runs_ = 0;
+    int improvements_ = 0;
+    std::thread thread_;
+};
+
+/**
+ * @brief Parse the name of a polish mode.
+ *
+ * @param name "off", "best" or "periodic".
+ * @param mode Output for the parsed mode.
+ *
+ * @return bool True if the name is known.
+ */
+bool parse_polish_mode(const std::string &name, PolishMode &mode);
+
+#endif // LOCAL_SEARCH_H
@@ -0,0 +1,42 @@
+#include "lower_bound.h"
+#include <algorithm>
+#include <limits>
+
+LowerBound taillard_lower_bound(const std::vector<std::vector<int>> &jobs, int jobs_num, int machines_num) {
+    std::vector<int> machine_load(machines_num, 0);
+    std::vector<int> min_head(machines_num, std::numeric_limits<int>::max());
+    std::vector<int> min_tail(machines_num, std::numeric_limits<int>::max());
+    int job_based = 0;
+
+    for (int j = 0; j < jobs_num; ++j) {
+        int job_total = 0;
+        for (int i = 0; i < machines_num; ++i) {
+            job_total += jobs[j][i];
+        }
+        job_based = std::max(job_based, job_total);
+
+        // head: work before machine i, tail: work after machine i
+        int head = 0;
+        for (int i = 0; i < machines_num; ++i) {
+            int tail = job_total - head - jobs[j][i];
+            machine_load[i] += jobs[j][i];
+            min_head[i] = std::min(min_head[i], head);
+            min_tail[i] = std::min(min_tail[i], tail);
+            head += jobs[j][i];
+        }
+    }
+
+    int machine_based = 0;
+    for (int i = 0; i < machines_num && jobs_num > 0; ++i) {
+        machine_based = std::max(machine_based, min_head[i] + machine_load[i] + min_tail[i]);
+    }
+
+    return {machine_based, job_based, std::max(machine_based, job_based)};
+}
+
+double optimality_gap(int c_max, int lower_bound) {
+    if (lower_bound <= 0) {
+        return 0.0;
+    }
+    return 100.0 * (c_max - lower_bound) / lower_bound;
+}
@@ -0,0 +1,47 @@
+#ifndef LOWER_BOUND_H
+#define LOWER_BOUND_H
+
+#include <vector>
+
+/**
+ * @brief Struct representing the makespan lower bounds of a flow-shop instance.
+ *
+ * This struct contains the machine-based and the job-based lower bounds of
+ * Taillard, together with the resulting combined bound (the larger of the two).
+ */
+struct LowerBound {
+    int machine_based;
+    int job_based;
+    int value;
+};
+
+/**
+ * @brief Calculate Taillard's makespan lower bound of a flow-shop instance.
+ *
+ * The function first precomputes, in a single pass over the processing times,
+ * the total load of every machine, the shortest head (work on the preceding
+ * machines) and the shortest tail (work on the following machines) of every
+ * machine, and the total processing time of every job. The machine-based bound
+ * is the largest head + load + tail over the machines, the job-based bound is
+ * the longest job. The whole calculation runs in O(n * m).
+ *
+ * @param jobs A 2D vector representing the processing times of jobs on each machine.
+ * @param jobs_num An integer representing the total number of jobs.
+ * @param machines_num An integer representing the total number of machines.
+ *
+ * @return LowerBound A struct containing the machine-based, the job-based and the
+ * combined lower bound.
+ */
+LowerBound taillard_lower_bound(const std::vector<std::vector<int>> &jobs, int jobs_num, int machines_num);
+
+/**
+ * @brief Calculate the optimality gap of a makespan relative to a lower bound.
+ *
+ * @param c_max The makespan of a schedule.
+ * @param lower_bound A lower bound of the optimal makespan.
+ *
+ * @return double The gap in percent, i.e. 100 * (c_max - lower_bound) / lower_bound.
+ */
+double optimality_gap(int c_max, int lower_bound);
+
+#endif // LOWER_BOUND_H
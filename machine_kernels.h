@@ -0,0 +1,56 @@
+#ifndef MACHINE_KERNELS_H
+#define MACHINE_KERNELS_H
+
+#include <algorithm>
+
+/**
+ * @brief Check if a machine count has a compile-time specialized kernel.
+ *
+ * Most instances have 5, 10 or 20 machines. For these the completion-time
+ * recurrence is instantiated with a constant machine count, so it is fully
+ * unrolled and its state fits into registers; any other count runs the generic
+ * loop of append_job().
+ */
+inline bool specialized_machines(int machines_num) {
+    return machines_num == 5 || machines_num == 10 || machines_num == 20;
+}
+
+// One step of the unrolled recurrence: machine I, then the ones behind it
+template<int I, int M, typename T>
+struct MachineChain {
+    static T run(const T *processing, T *state, T c) {
+        c = static_cast<T>(std::max(c, state[I]) + processing[I]);
+        state[I] = c;
+        return MachineChain<I + 1, M, T>::run(processing, state, c);
+    }
+};
+
+template<int M, typename T>
+struct MachineChain<M, M, T> {
+    static T run(const T *, T *, T c) { return c; }
+};
+
+/**
+ * @brief Append a job to a partial schedule of M machines, M known at compile time.
+ *
+ * The counterpart of append_job() with a constant machine count: the setup
+ * additions have a constant trip count the compiler vectorizes, and the maximum
+ * chain along the machines is unrolled into straight-line code.
+ *
+ * @param processing The M processing times of the job.
+ * @param setup The M setup times before the job, nullptr for none.
+ * @param state The completion times on every machine, updated in place.
+ *
+ * @return T The completion time of the job on the last machine.
+ */
+template<int M, typename T>
+inline T append_job_fixed(const T *processing, const int *setup, T *state) {
+    if (setup != nullptr) {
+        for (int i = 0; i < M; ++i) {
+            state[i] = static_cast<T>(state[i] + setup[i]);
+        }
+    }
+    return MachineChain<0, M, T>::run(processing, state, 0);
+}
+
+#endif // MACHINE_KERNELS_H
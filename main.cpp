@@ -5,24 +5,264 @@
 #include "deadlines.h"
 #include "flow_shop.h"
 #include "simulated_annealing.h"
+#include "lower_bound.h"
+#include "neh.h"
+#include "tardiness_seeds.h"
+#include "gantt.h"
+#include "result_export.h"
+#include "instance_generator.h"
+#include "island_model.h"
+#include "batch_runner.h"
+#include "tuner.h"
+#include "no_wait.h"
+#include "machine_kernels.h"
+#include "simd_kernels.h"
+#include "solver_server.h"
+#include <thread>
 #include <chrono>
 #include <iomanip>
+#include <memory>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
 
 // Function declarations
 void separator();
 
+void print_move_stats(const AnnealingStats &stats);
+
+void print_overflow(const AnnealingStats &stats, long long budget);
+
+void print_island_stats(const IslandResult &result);
+
+void print_criteria(const CriteriaValues &values);
+
+int run_sweep(const std::string &spec_path, ExportFormat format, const std::string &output, int threads);
+
+int run_tuner(const std::string &spec_path, const std::string &output, long long budget, int threads);
+
+std::string option_value(int argc, char *argv[], const std::string &name, const std::string &fallback);
+
+bool long_option(int argc, char *argv[], const std::string &name, long long fallback, long long &value);
+
+bool int_option(int argc, char *argv[], const std::string &name, int fallback, int &value);
+
+bool double_option(int argc, char *argv[], const std::string &name, double fallback, double &value);
+
+void output_gantt(GanttFormat format, const std::string &output_prefix, const std::string &suffix,
+                  const std::vector<std::vector<int>> &jobs, const std::vector<int> &order,
+                  const std::vector<std::vector<int>> &job_end);
+
 template<typename T>
 void print_vector(const std::vector<T> &vec);
 
-ObjectFunctionResult
-object_function(const std::vector<std::vector<int>> &jobs, const std::vector<int> &order, int jobs_num,
-                int machines_num, const std::vector<int> &deadlines);
-
 
 void separator() {
     std::cout << "\n>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\n";
 }
 
+void print_criteria(const CriteriaValues &values) {
+    std::cout << "Criteria: Cmax " << values.c_max << ", \u03A3Ci " << values.flowtime << ", \u03A3Ti " << values.t_sum
+              << ", \u03A3wiTi " << values.weighted_tardiness << ", Lmax " << values.max_lateness << ", \u03A3Ui "
+              << values.tardy_jobs << "\n";
+}
+
+void print_move_stats(const AnnealingStats &stats) {
+    if (!stats.restarts.empty()) {
+        int improved = 0;
+        for (const RestartEvent &event: stats.restarts) {
+            improved += event.best_after < event.best_before;
+        }
+        std::cout << "Restarts (" << restart_strategy_name(stats.restarts.front().strategy) << "): "
+                  << stats.restarts.size() << ", " << improved << " found a new best\n";
+        for (const RestartEvent &event: stats.restarts) {
+            std::cout << "  after " << event.evaluation << " evaluations: best " << event.best_before << ", start "
+                      << event.start_value << ", reached " << event.best_after << "\n";
+        }
+    }
+    if (stats.polish_runs > 0 || stats.polish_gain > 0) {
+        std::cout << "Polished: " << stats.polish_runs << " orders, " << stats.polish_improvements
+                  << " fed back, final descent gained " << stats.polish_gain << "\n";
+    }
+    if (stats.calibration_samples > 0) {
+        std::cout << "Calibrated from " << stats.calibration_samples << " samples: t0 " << stats.t0 << ", alpha "
+                  << std::defaultfloat << std::setprecision(6) << stats.alpha << "\n";
+    }
+    std::cout << "Accepted: " << stats.accepted << "/" << stats.evaluations << ", reheats: " << stats.reheats
+              << ", final temperature: " << stats.final_temperature << "\n";
+    std::cout << "Cache hits: " << stats.cache_hits << "/" << stats.cache_hits + stats.cache_misses << "\n";
+    for (int k = 0; k < MOVE_TYPE_COUNT; ++k) {
+        if (stats.move_uses[k] > 0) {
+            std::cout << "  " << move_type_name(static_cast<MoveType>(k)) << ": " << stats.move_uses[k]
+                      << " moves, " << stats.move_improvements[k] << " improving\n";
+        }
+    }
+}
+
+// Reports a run the engine ended early because an objective value did not fit into an int
+void print_overflow(const AnnealingStats &stats, long long budget) {
+    if (!stats.overflow.empty()) {
+        std::cout << "\n!!! Overflow Error - Exited at: " << stats.evaluations << "/" << budget << " !!!\n";
+        std::cerr << "Overflow error: " << stats.overflow << std::endl;
+    }
+}
+
+void print_island_stats(const IslandResult &result) {
+    std::cout << "Islands: " << result.islands << " (" << result.failed_islands << " failed), best island: "
+              << result.best_island << "\n";
+    std::cout << "Migrants: " << result.migrants_sent << " sent, " << result.migrants_accepted << " accepted\n";
+}
+
+// Runs every combination of a sweep specification and streams the results to the output file
+int run_sweep(const std::string &spec_path, ExportFormat format, const std::string &output, int threads) {
+    SweepSpec spec;
+    std::vector<Instance> instances;
+    std::string error;
+    if (!parse_sweep_spec(spec_path, spec, error) || !sweep_instances(spec, instances, error)) {
+        std::cerr << "Invalid sweep: " << error << std::endl;
+        return 1;
+    }
+    std::vector<BatchTask> tasks = expand_sweep(spec, instances);
+    std::FILE *file = std::fopen(output.c_str(), "ab");
+    if (file == nullptr) {
+        std::cerr << "Could not open " << output << std::endl;
+        return 1;
+    }
+    std::cout << "Sweep: " << instances.size() << " instances, " << tasks.size() << " runs\n";
+    AnnealingOptions options;
+    options.cache_size = 1 << 16;
+    ResultWriter writer(file, format);
+    BatchStats stats = run_batch(spec, instances, tasks, object_function, options, threads, writer);
+    std::fclose(file);
+    std::cout << "Runs: " << stats.tasks << ", evaluations: " << stats.evaluations << ", steals: " << stats.steals
+              << "\n";
+    std::cout << "Runtime: " << std::fixed << std::setprecision(3) << stats.runtime_seconds << " seconds ("
+              << std::setprecision(1) << stats.tasks / std::max(stats.runtime_seconds, 1e-9) << " runs/s)\n";
+    if (stats.overflows > 0) {
+        std::cerr << stats.overflows << " runs overflowed an int and wrote no result" << std::endl;
+    }
+    std::cout << "Results written to " << output << "\n";
+    return stats.failed_writes == 0 && stats.overflows == 0 ? 0 : 1;
+}
+
+// Races schedule configurations over the instances of a sweep specification and saves the winner
+int run_tuner(const std::string &spec_path, const std::string &output, long long budget, int threads) {
+    SweepSpec spec;
+    std::vector<Instance> instances;
+    std::string error;
+    if (!parse_sweep_spec(spec_path, spec, error) || !sweep_instances(spec, instances, error)) {
+        std::cerr << "Invalid training set: " << error << std::endl;
+        return 1;
+    }
+    RacingOptions racing;
+    racing.budget = budget;
+    racing.threads = threads;
+    AnnealingOptions options;
+    options.cache_size = 1 << 16;
+    RacingStats stats;
+    auto start_time = std::chrono::high_resolution_clock::now();
+    TunedConfig config = race_configurations(spec, instances, object_function, options, racing, &stats);
+    double runtime = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count();
+    std::cout << "Configurations: " << stats.configurations << ", races: " << stats.races << ", runs: " << stats.runs
+              << ", survivors: " << stats.survivors << "\n";
+    std::cout << "Tuned: " << cooling_strategy_name(config.cooling_strategy) << ", alpha " << config.alpha
+              << ", neighbors " << config.neighbors << ", t0 " << config.t0 << " (mean deviation "
+              << std::fixed << std::setprecision(2) << stats.mean_score * 100 << "%)\n";
+    std::cout << "Runtime: " << std::setprecision(3) << runtime << " seconds\n";
+    if (!save_config(output, config)) {
+        std::cerr << "Could not write " << output << std::endl;
+        return 1;
+    }
+    std::cout << "Configuration written to " << output << "\n";
+    return 0;
+}
+
+// Returns the value of a --name=value command line option, or fallback if it is not given
+std::string option_value(int argc, char *argv[], const std::string &name, const std::string &fallback) {
+    std::string prefix = "--" + name + "=";
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.compare(0, prefix.size(), prefix) == 0) {
+            return arg.substr(prefix.size());
+        }
+    }
+    return fallback;
+}
+
+// Reads an integer --name=value option, fallback if it is not given; false with a message if it is not an integer
+bool long_option(int argc, char *argv[], const std::string &name, long long fallback, long long &value) {
+    std::string text = option_value(argc, argv, name, "");
+    if (text.empty()) {
+        value = fallback;
+        return true;
+    }
+    char *end;
+    errno = 0;
+    value = std::strtoll(text.c_str(), &end, 10);
+    if (*end != '\0' || errno == ERANGE) {
+        std::cerr << "Invalid --" << name << " value " << text << ", expected an integer" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool int_option(int argc, char *argv[], const std::string &name, int fallback, int &value) {
+    long long parsed;
+    if (!long_option(argc, argv, name, fallback, parsed)) {
+        return false;
+    }
+    if (parsed < INT_MIN || parsed > INT_MAX) {
+        std::cerr << "The --" << name << " value " << parsed << " is out of range" << std::endl;
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+bool double_option(int argc, char *argv[], const std::string &name, double fallback, double &value) {
+    std::string text = option_value(argc, argv, name, "");
+    if (text.empty()) {
+        value = fallback;
+        return true;
+    }
+    char *end;
+    value = std::strtod(text.c_str(), &end);
+    if (*end != '\0' || !std::isfinite(value)) {
+        std::cerr << "Invalid --" << name << " value " << text << ", expected a number" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Writes the chart to <output_prefix>_<suffix>.<ext>, or to the standard output without a prefix
+void output_gantt(GanttFormat format, const std::string &output_prefix, const std::string &suffix,
+                  const std::vector<std::vector<int>> &jobs, const std::vector<int> &order,
+                  const std::vector<std::vector<int>> &job_end) {
+    if (output_prefix.empty() && format == GanttFormat::text) {
+        print_flow_shop(jobs, order, job_end);
+        return;
+    }
+    std::string chart;
+    render_gantt(chart, format, jobs, order, job_end);
+    if (output_prefix.empty()) {
+        std::cout.flush();
+        write_buffer(stdout, chart);
+        return;
+    }
+    std::string path = output_prefix + "_" + suffix + "." + gantt_format_extension(format);
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr || !write_buffer(file, chart)) {
+        std::cerr << "Could not write " << path << std::endl;
+    } else {
+        std::cout << "Gantt chart written to " << path << "\n";
+    }
+    if (file != nullptr) {
+        std::fclose(file);
+    }
+}
+
 template<typename T>
 void print_vector(const std::vector<T> &vec) {
     for (const auto &elem: vec) {
@@ -31,29 +271,232 @@ void print_vector(const std::vector<T> &vec) {
     std::cout << "\n";
 }
 
-int main() {
+int main(int argc, char *argv[]) {
+    // OPTIONS
+    // the SIMD kernels (setups, insertion, tardiness sums; not the completion-time recurrence) default to the
+    // best instruction set of the CPU, --isa forces one for benchmarking
+    std::string isa_value = option_value(argc, argv, "isa", "");
+    Isa isa = Isa::generic;
+    if (!isa_value.empty() && !parse_isa(isa_value, isa)) {
+        std::cerr << "Unknown instruction set, use generic, sse4.2, avx2 or avx512" << std::endl;
+        return 1;
+    }
+    if (!isa_value.empty() && !select_isa(isa)) {
+        std::cerr << "This CPU does not support " << isa_name(isa) << std::endl;
+        return 1;
+    }
+    GanttFormat gantt_format = GanttFormat::text;
+    if (!parse_gantt_format(option_value(argc, argv, "gantt-format", "text"), gantt_format)) {
+        std::cerr << "Unknown Gantt chart format, use text, svg or csv" << std::endl;
+        return 1;
+    }
+    std::string gantt_output = option_value(argc, argv, "gantt-output", "");
+    std::string export_name = option_value(argc, argv, "export", "");
+    ExportFormat export_format = ExportFormat::jsonl;
+    if (!export_name.empty() && !parse_export_format(export_name, export_format)) {
+        std::cerr << "Unknown export format, use jsonl, csv or binary" << std::endl;
+        return 1;
+    }
+    std::string export_output = option_value(argc, argv, "export-output",
+                                             export_name == "binary" ? "results.bin" : "results." + export_name);
+    GeneratorOptions generator;
+    long long seed;
+    if (!long_option(argc, argv, "seed", std::chrono::system_clock::now().time_since_epoch().count(), seed)) {
+        return 1;
+    }
+    generator.seed = static_cast<unsigned long long>(seed);
+    generator.distribution = TimeDistribution::uniform;
+    if (!parse_time_distribution(option_value(argc, argv, "distribution", "uniform"), generator.distribution)) {
+        std::cerr << "Unknown distribution, use taillard, uniform or exponential" << std::endl;
+        return 1;
+    }
+    if (!int_option(argc, argv, "min-time", 1, generator.min_time) ||
+        !int_option(argc, argv, "max-time", 8, generator.max_time) ||
+        !double_option(argc, argv, "tightness", 0.3, generator.tightness) ||
+        !double_option(argc, argv, "due-range", 0.6, generator.range) ||
+        !int_option(argc, argv, "setup-max", 0, generator.setup_max) ||
+        !int_option(argc, argv, "setup-families", 0, generator.setup_families) ||
+        !int_option(argc, argv, "weight-max", 0, generator.weight_max)) {
+        return 1;
+    }
+    generator.threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string shop = option_value(argc, argv, "shop", "permutation");
+    if (shop != "permutation" && shop != "no-wait") {
+        std::cerr << "Unknown flow shop variant, use permutation or no-wait" << std::endl;
+        return 1;
+    }
+    // the makespan run solves the chosen variant, the tardiness run stays a permutation flow shop
+    Objective cmax_objective = shop == "no-wait" ? Objective::no_wait_c_max : Objective::c_max;
+    ObjectFunction cmax_function = shop == "no-wait" ? no_wait_object_function : object_function;
+    // the second run minimizes a permutation flow-shop objective of the registry, total tardiness by default
+    Objective objective = Objective::t_sum;
+    if (!parse_objective(option_value(argc, argv, "objective", "t_sum"), objective) ||
+        objective == Objective::no_wait_c_max) {
+        std::cerr << "Unknown objective, use";
+        for (const ObjectiveInfo &info: objective_registry()) {
+            if (info.objective != Objective::no_wait_c_max) {
+                std::cerr << " " << info.name;
+            }
+        }
+        std::cerr << std::endl;
+        return 1;
+    }
+    CriteriaWeights combination;
+    if (!parse_criteria_weights(option_value(argc, argv, "weights", ""), combination)) {
+        std::cerr << "Invalid weights, use name:coefficient pairs such as c_max:1,t_sum:2" << std::endl;
+        return 1;
+    }
+    if (objective == Objective::weighted_sum && !has_criteria(combination)) {
+        std::cerr << "The weighted_sum objective needs --weights" << std::endl;
+        return 1;
+    }
+    const ObjectiveInfo &objective_entry = objective_info(objective);
+    std::string islands_value = option_value(argc, argv, "islands", "");
+    IslandOptions island_options;
+    if ((islands_value != "all" && !int_option(argc, argv, "islands", 0, island_options.islands)) ||
+        !int_option(argc, argv, "migration-interval", 10, island_options.migration_interval)) {
+        return 1;
+    }
+    if (!parse_migration_topology(option_value(argc, argv, "topology", "ring"), island_options.topology)) {
+        std::cerr << "Unknown migration topology, use ring, broadcast or random" << std::endl;
+        return 1;
+    }
+    int threads;
+    if (!int_option(argc, argv, "threads", 0, threads)) {
+        return 1;
+    }
+    std::string sweep_path = option_value(argc, argv, "sweep", "");
+    if (!sweep_path.empty()) {
+        return run_sweep(sweep_path, export_format, export_name.empty() ? "results.jsonl" : export_output, threads);
+    }
+    std::string tune_path = option_value(argc, argv, "tune", "");
+    if (!tune_path.empty()) {
+        long long budget;
+        if (!long_option(argc, argv, "budget", 20000, budget)) {
+            return 1;
+        }
+        return run_tuner(tune_path, option_value(argc, argv, "config-output", "tuned.cfg"), budget, threads);
+    }
+    std::string socket_path = option_value(argc, argv, "serve", "");
+    if (!socket_path.empty()) {
+        ServerOptions server;
+        server.socket_path = socket_path;
+        server.workers = threads;
+        long long max_request_bytes;
+        if (!int_option(argc, argv, "queue", server.queue_capacity, server.queue_capacity) ||
+            !int_option(argc, argv, "max-connections", server.max_connections, server.max_connections) ||
+            !int_option(argc, argv, "cached-instances", server.cached_instances, server.cached_instances) ||
+            !long_option(argc, argv, "max-request-bytes", server.max_request_bytes, max_request_bytes)) {
+            return 1;
+        }
+        if (max_request_bytes <= 0) {
+            std::cerr << "The --max-request-bytes value must be positive" << std::endl;
+            return 1;
+        }
+        server.max_request_bytes = max_request_bytes;
+        return run_server(server);
+    }
+    std::string config_path = option_value(argc, argv, "config", "");
+    TunedConfig config;
+    std::string config_error;
+    if (!config_path.empty() && !load_config(config_path, config, config_error)) {
+        std::cerr << "Invalid configuration: " << config_error << std::endl;
+        return 1;
+    }
+    int neighbors_num = config.neighbors;
+    int reheat_after;
+    if (!int_option(argc, argv, "reheat-after", 0, reheat_after)) {
+        return 1;
+    }
+    RestartOptions restart;
+    if (!parse_restart_strategy(option_value(argc, argv, "restart", "none"), restart.strategy)) {
+        std::cerr << "Unknown restart strategy, use none, perturb, elite or constructive" << std::endl;
+        return 1;
+    }
+    if (!int_option(argc, argv, "stagnation-epochs", 50, restart.stagnation_epochs) ||
+        !double_option(argc, argv, "min-acceptance", 0, restart.min_acceptance) ||
+        !int_option(argc, argv, "kick", 0, restart.kick_moves)) {
+        return 1;
+    }
+    PolishOptions polish;
+    if (!parse_polish_mode(option_value(argc, argv, "polish", "off"), polish.mode)) {
+        std::cerr << "Unknown polish mode, use off, best or periodic" << std::endl;
+        return 1;
+    }
+    double reheat_fraction;
+    if (!int_option(argc, argv, "polish-interval", 50, polish.interval) ||
+        !int_option(argc, argv, "destruction", 4, polish.destruction) ||
+        !int_option(argc, argv, "greedy-iterations", 20, polish.greedy_iterations) ||
+        !double_option(argc, argv, "reheat-fraction", 0.5, reheat_fraction)) {
+        return 1;
+    }
+    std::string instance_path = option_value(argc, argv, "instance", "");
+    std::string write_instance_path = option_value(argc, argv, "write-instance", "");
+    Instance instance;
+    if (!instance_path.empty() && !load_instance(instance_path, instance)) {
+        std::cerr << "Could not read the instance " << instance_path << std::endl;
+        return 1;
+    }
+
     // The console code page needs to be set to UTF-8 in order to be able to print out the "Σ" character
     system("chcp 65001");
 
     // INPUTS
-    int jobs_num, machines_num, iteration_num, cooling_strategy, init_temperature;
-    std::cout << "Number of Jobs: ";
-    std::cin >> jobs_num;
-    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-    std::cout << "Number of Machines: ";
-    std::cin >> machines_num;
-    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    int jobs_num, machines_num, iteration_num, cooling_strategy, init_temperature, init_solution, neighborhood;
+    if (instance_path.empty()) {
+        std::cout << "Number of Jobs: ";
+        std::cin >> jobs_num;
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        std::cout << "Number of Machines: ";
+        std::cin >> machines_num;
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        instance = generate_instance(jobs_num, machines_num, generator);
+        std::cout << "Instance: " << instance.name << "\n";
+    } else {
+        jobs_num = instance.jobs_num;
+        machines_num = instance.machines_num;
+        if (instance.deadlines.empty()) {
+            generate_due_dates(instance, generator);
+        }
+        std::cout << "Instance: " << instance.name << " (" << jobs_num << " jobs, " << machines_num << " machines)\n";
+    }
+    if (!write_instance_path.empty()) {
+        if (!save_instance(write_instance_path, instance)) {
+            std::cerr << "Could not write the instance " << write_instance_path << std::endl;
+            return 1;
+        }
+        std::cout << "Instance written to " << write_instance_path << "\n";
+    }
     std::cout << "Number of Iterations: ";
     std::cin >> iteration_num;
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    if (config_path.empty()) {
+        std::cout << "============================\n"
+                  << "COOLING STRATEGIES\n1 | Linear Multiplicative Type 1\n2 | Linear Multiplicative Type 2\n3 | Exponential Multiplicative\n4 | Logarithmical Multiplicative\n5 | Non-monotonic\n6 | Adaptive (Lam-Delosme)\n"
+                  << "============================\n";
+        std::cout << "Number of the cooling strategy: ";
+        std::cin >> cooling_strategy;
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        std::cout << "Initial temperature (0 to calibrate): ";
+        std::cin >> init_temperature;
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    } else {
+        cooling_strategy = config.cooling_strategy;
+        init_temperature = config.t0;
+        std::cout << "Configuration: " << cooling_strategy_name(cooling_strategy) << ", alpha " << config.alpha
+                  << ", neighbors " << neighbors_num << ", t0 " << init_temperature << "\n";
+    }
     std::cout << "============================\n"
-              << "COOLING STRATEGIES\n1 | Linear Multiplicative Type 1\n2 | Linear Multiplicative Type 2\n3 | Exponential Multiplicative\n4 | Logarithmical Multiplicative\n5 | Non-monotonic\n"
+              << "INITIAL SOLUTIONS\n1 | Random\n2 | Constructive (NEH for Cmax, best due-date rule for \u03A3Ti)\n"
               << "============================\n";
-    std::cout << "Number of the cooling strategy: ";
-    std::cin >> cooling_strategy;
+    std::cout << "Number of the initial solution: ";
+    std::cin >> init_solution;
     std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-    std::cout << "Initial temperature: ";
-    std::cin >> init_temperature;
+    std::cout << "============================\n"
+              << "NEIGHBORHOODS\n1 | Swap\n2 | Adaptive (adjacent swap, swap, insertion, block move, reversal)\n"
+              << "============================\n";
+    std::cout << "Number of the neighborhood: ";
+    std::cin >> neighborhood;
 
     // ARRANGING INPUTS
     std::vector<int> init_order(jobs_num);
@@ -63,31 +506,151 @@ int main() {
 
     // INITIALIZATION
     auto start_time = std::chrono::high_resolution_clock::now();
-    std::vector<std::vector<int>> jobs = jobs_input(jobs_num, machines_num);
-    std::vector<int> gen_deadlines = generate_deadlines(machines_num, jobs_num,
-                                                        deadline_length(jobs, init_order, jobs_num, machines_num));
-    std::vector<int> order = simulated_annealing_cmax(jobs, init_order, object_function, iteration_num, 100,
-                                                      init_temperature, jobs_num,
-                                                      machines_num, cooling_strategy, gen_deadlines);
-    std::vector<int> order2 = simulated_annealing_tsum(jobs, init_order, object_function, iteration_num, 100,
-                                                       init_temperature, jobs_num,
-                                                       machines_num, cooling_strategy, gen_deadlines);
-    auto result = object_function(jobs, order, jobs_num, machines_num, gen_deadlines);
-    auto result2 = object_function(jobs, order2, jobs_num, machines_num, gen_deadlines);
-    auto deadlines = calculate_deadlines(jobs, result.job_end, gen_deadlines);
-    auto deadlines2 = calculate_deadlines(jobs, result2.job_end, gen_deadlines);
-
-    // Here I assume that the runtime ie. the calculations end when the printing out starts
+    std::vector<std::vector<int>> jobs = jobs_matrix(instance);
+    std::vector<int> gen_deadlines = instance.deadlines;
+    std::unique_ptr<SetupTimes> setups;
+    if (!instance.setups.empty()) {
+        if (cmax_objective == Objective::no_wait_c_max) {
+            std::cerr << "The no-wait flow shop does not support setup times" << std::endl;
+            return 1;
+        }
+        setups.reset(new SetupTimes(jobs_num, machines_num, instance.setups));
+        std::cout << "Setup times: " << setup_storage_name(setups->storage()) << " storage, " << setups->memory()
+                  << " bytes\n";
+    }
+    TimeWidth time_width = choose_time_width(completion_time_bound(jobs, jobs_num, machines_num, setups.get()));
+    std::cout << "Completion times: " << time_width_name(time_width)
+              << (specialized_machines(machines_num) ? ", unrolled kernel" : ", generic kernel") << "\n";
+    std::cout << "SIMD kernels: " << isa_name(active_isa()) << "\n";
+    std::vector<int> start_order = init_order;
+    std::vector<int> start_order2 = init_order;
+    TardinessRule tardiness_rule = TardinessRule::edd;
+    if (init_solution == 2) {
+        NehOptions neh_options;
+        neh_options.threads = std::max(1u, std::thread::hardware_concurrency());
+        start_order = neh(jobs, jobs_num, machines_num, neh_options);
+        ObjectiveContext seed_context;
+        seed_context.setups = setups.get();
+        seed_context.job_weights = instance.weights;
+        seed_context.combination = combination;
+        start_order2 = objective_entry.due_dates
+                       ? best_tardiness_seed(jobs, jobs_num, machines_num, gen_deadlines, objective, &seed_context,
+                                             &tardiness_rule)
+                       : neh(jobs, jobs_num, machines_num, neh_options);
+    }
+    LowerBound lower_bound = taillard_lower_bound(jobs, jobs_num, machines_num);
+    AnnealingOptions tsum_options;
+    tsum_options.alpha = config.alpha;
+    tsum_options.reheat_after = reheat_after;
+    tsum_options.reheat_fraction = reheat_fraction;
+    tsum_options.restart = restart;
+    tsum_options.polish = polish;
+    tsum_options.setups = setups.get();
+    tsum_options.job_weights = instance.weights;
+    tsum_options.combination = combination;
+    tsum_options.lower_bound = trivial_lower_bound(objective, combination);
+    tsum_options.calibration.threads = std::max(1u, std::thread::hardware_concurrency());
+    tsum_options.cache_size = 1 << 16;
+    if (neighborhood == 2) {
+        tsum_options.moves = {MoveType::adjacent_swap, MoveType::swap, MoveType::insertion, MoveType::block_move,
+                              MoveType::reversal};
+        tsum_options.adaptive_moves = true;
+    }
+    AnnealingOptions cmax_options = tsum_options;
+    cmax_options.lower_bound = lower_bound.value;
+    AnnealingStats cmax_stats, tsum_stats;
+    IslandResult cmax_islands, tsum_islands;
+    std::vector<int> order, order2;
+    auto cmax_start_time = std::chrono::high_resolution_clock::now();
+    if (islands_value.empty() && cmax_objective == Objective::no_wait_c_max) {
+        order = simulated_annealing_no_wait(jobs, start_order, cmax_function, iteration_num, neighbors_num,
+                                            init_temperature, jobs_num, machines_num, cooling_strategy,
+                                            gen_deadlines, cmax_options, &cmax_stats);
+    } else if (islands_value.empty()) {
+        order = simulated_annealing_cmax(jobs, start_order, object_function, iteration_num, neighbors_num,
+                                         init_temperature, jobs_num, machines_num, cooling_strategy, gen_deadlines,
+                                         cmax_options, &cmax_stats);
+    } else {
+        cmax_islands = run_islands(cmax_objective, jobs, start_order, cmax_function, iteration_num,
+                                   neighbors_num, init_temperature, jobs_num, machines_num, cooling_strategy,
+                                   gen_deadlines, cmax_options, island_options);
+        order = cmax_islands.order;
+        cmax_stats.evaluations = cmax_islands.evaluations;
+        cmax_stats.reached_lower_bound = cmax_islands.value <= cmax_options.lower_bound;
+    }
+    print_overflow(cmax_stats, static_cast<long long>(iteration_num) * neighbors_num);
+    auto tsum_start_time = std::chrono::high_resolution_clock::now();
+    if (islands_value.empty()) {
+        order2 = simulated_annealing(objective, jobs, start_order2, object_function, iteration_num, neighbors_num,
+                                     init_temperature, jobs_num, machines_num, cooling_strategy, gen_deadlines,
+                                     tsum_options, &tsum_stats);
+    } else {
+        tsum_islands = run_islands(objective, jobs, start_order2, object_function, iteration_num,
+                                   neighbors_num, init_temperature, jobs_num, machines_num, cooling_strategy,
+                                   gen_deadlines, tsum_options, island_options);
+        order2 = tsum_islands.order;
+        tsum_stats.evaluations = tsum_islands.evaluations;
+        tsum_stats.reached_lower_bound = tsum_islands.value <= tsum_options.lower_bound;
+    }
+    print_overflow(tsum_stats, static_cast<long long>(iteration_num) * neighbors_num);
+
+    // The runtime ends with the solver, the reports below are generated outside the timed part
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+    ObjectFunctionResult result, result2;
+    Deadlines deadlines, deadlines2;
+    CriteriaValues criteria, criteria2;
+    int value, value2;
+    // every reported criterion has to fit into an int, not only the objectives the runs minimized
+    try {
+        result = setups ? setup_object_function(jobs, *setups, order, jobs_num, machines_num, gen_deadlines)
+                        : cmax_function(jobs, order, jobs_num, machines_num, gen_deadlines);
+        result2 = setups ? setup_object_function(jobs, *setups, order2, jobs_num, machines_num, gen_deadlines)
+                         : object_function(jobs, order2, jobs_num, machines_num, gen_deadlines);
+        deadlines = calculate_deadlines(jobs, result.job_end, gen_deadlines, order);
+        deadlines2 = calculate_deadlines(jobs, result2.job_end, gen_deadlines, order2);
+        criteria = schedule_criteria(result.job_end, order, gen_deadlines, instance.weights);
+        criteria2 = schedule_criteria(result2.job_end, order2, gen_deadlines, instance.weights);
+        value = combine_criteria(criteria, criteria_weights(cmax_objective, combination));
+        value2 = combine_criteria(criteria2, criteria_weights(objective, combination));
+    } catch (std::overflow_error &e) {
+        std::cerr << "Overflow error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    // EXPORTING THE RESULTS
+    if (!export_name.empty()) {
+        std::FILE *file = std::fopen(export_output.c_str(), "ab");
+        if (file == nullptr) {
+            std::cerr << "Could not open " << export_output << std::endl;
+            return 1;
+        }
+        ResultWriter writer(file, export_format);
+        RunMetadata metadata = {shop == "no-wait" ? "no_wait_c_max" : "c_max", instance.name, jobs_num,
+                                machines_num, iteration_num, neighbors_num, cooling_strategy, cmax_stats.t0,
+                                cmax_options.seed, cmax_stats.evaluations,
+                                std::chrono::duration<double>(tsum_start_time - cmax_start_time).count()};
+        bool written = writer.write(make_result_record(metadata, order, value, criteria, deadlines));
+        metadata.objective = objective_entry.name;
+        metadata.t0 = tsum_stats.t0;
+        metadata.evaluations = tsum_stats.evaluations;
+        metadata.runtime_seconds = std::chrono::duration<double>(end_time - tsum_start_time).count();
+        written = writer.write(make_result_record(metadata, order2, value2, criteria2, deadlines2)) && written;
+        std::fclose(file);
+        if (!written) {
+            std::cerr << "Could not write " << export_output << std::endl;
+            return 1;
+        }
+    }
+
     // PRINTING OUT THE RESULTS
     separator();
     std::cout << "CMAX ";
-    print_flow_shop(machines_num, jobs_num, result.job_begin, result.job_end);
+    output_gantt(gantt_format, gantt_output, "cmax", jobs, order, result.job_end);
 
     separator();
     std::cout << "\u03A3" << "Ti ";
-    print_flow_shop(machines_num, jobs_num, result2.job_begin, result2.job_end);
+    output_gantt(gantt_format, gantt_output, "tsum", jobs, order2, result2.job_end);
 
     separator();
     std::cout << "CMAX ";
@@ -98,22 +661,55 @@ int main() {
     print_deadlines_table(deadlines2.end_times, jobs, deadlines2.jobs_l, deadlines2.jobs_t, deadlines2.deadlines);
 
     separator();
-    std::cout << "Cmax data:\n";
+    std::cout << (shop == "no-wait" ? "No-wait Cmax data:\n" : "Cmax data:\n");
     std::cout << "Initial order: ";
-    print_vector(init_order);
+    print_vector(start_order);
     std::cout << "Best order: ";
     print_vector(order);
     std::cout << "C-max: " << result.c_max << "\n";
     std::cout << "T-sum: " << deadlines.t_sum << "\n";
+    std::cout << "Lower bound: " << lower_bound.value << " (machine-based: " << lower_bound.machine_based
+              << ", job-based: " << lower_bound.job_based << ")\n";
+    std::cout << "Optimality gap: " << std::fixed << std::setprecision(2)
+              << optimality_gap(result.c_max, lower_bound.value) << "%\n";
+    print_criteria(criteria);
+    std::cout << "Evaluations: " << cmax_stats.evaluations << "/"
+              << static_cast<long long>(iteration_num) * neighbors_num * std::max(1, cmax_islands.islands)
+              << (cmax_stats.reached_lower_bound ? " (stopped at the lower bound)" : "") << "\n";
+    if (islands_value.empty()) {
+        print_move_stats(cmax_stats);
+    } else {
+        print_island_stats(cmax_islands);
+    }
 
     separator();
-    std::cout << "ΣTi data:\n";
+    if (objective == Objective::t_sum) {
+        std::cout << "ΣTi data:\n";
+    } else {
+        std::cout << objective_entry.name << " data (" << objective_entry.description << "):\n";
+    }
     std::cout << "Initial order: ";
-    print_vector(init_order);
+    print_vector(start_order2);
+    if (init_solution == 2) {
+        std::cout << "Initial rule: " << tardiness_rule_name(tardiness_rule) << "\n";
+    }
     std::cout << "Best order: ";
     print_vector(order2);
     std::cout << "C-max: " << result2.c_max << "\n";
     std::cout << "T-sum: " << deadlines2.t_sum << "\n";
+    if (objective != Objective::t_sum) {
+        std::cout << "Objective: " << value2 << "\n";
+    }
+    print_criteria(criteria2);
+    std::cout << "Evaluations: " << tsum_stats.evaluations << "/"
+              << static_cast<long long>(iteration_num) * neighbors_num * std::max(1, tsum_islands.islands)
+              << (!tsum_stats.reached_lower_bound ? ""
+                  : objective == Objective::t_sum ? " (stopped at zero tardiness)" : " (stopped at zero)") << "\n";
+    if (islands_value.empty()) {
+        print_move_stats(tsum_stats);
+    } else {
+        print_island_stats(tsum_islands);
+    }
 
     separator();
 
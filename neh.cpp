@@ -0,0 +1,109 @@
+#include "neh.h"
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include "simd_kernels.h"
+
+// Below this many cells of insertion work a thread costs more than it saves
+static const int PARALLEL_MIN_CELLS = 1 << 14;
+
+static void evaluate_positions(const std::vector<std::vector<int>> &jobs, int machines_num, int job, int stride,
+                               TaillardWorkspace &workspace, int from, int to) {
+    simd_kernels().insertion_makespans(jobs[job - 1].data(), machines_num, stride, from, to, workspace.head.data(),
+                                       workspace.tail.data(), workspace.front.data(), workspace.makespan.data());
+}
+
+InsertionResult taillard_insertion(const std::vector<std::vector<int>> &jobs, int machines_num,
+                                   const std::vector<int> &sequence, int job, NehTieBreaking tie_breaking,
+                                   std::mt19937 &rng, int threads, TaillardWorkspace &workspace) {
+    int k = sequence.size();
+    int stride = k + 1;
+    workspace.head.resize(machines_num * stride);
+    workspace.tail.resize(machines_num * stride);
+    workspace.front.resize(stride);
+    workspace.makespan.resize(stride);
+    std::vector<int> &head = workspace.head;
+    std::vector<int> &tail = workspace.tail;
+
+    // heads: completion time of position p on machine i
+    for (int i = 0; i < machines_num; ++i) {
+        for (int p = 0; p < k; ++p) {
+            int above = i > 0 ? head[(i - 1) * stride + p] : 0;
+            int left = p > 0 ? head[i * stride + p - 1] : 0;
+            head[i * stride + p] = std::max(above, left) + jobs[sequence[p] - 1][i];
+        }
+    }
+    // tails: time from the start of position p on machine i to the end of the schedule
+    for (int i = machines_num - 1; i >= 0; --i) {
+        tail[i * stride + k] = 0;
+        for (int p = k - 1; p >= 0; --p) {
+            int below = i < machines_num - 1 ? tail[(i + 1) * stride + p] : 0;
+            int right = tail[i * stride + p + 1];
+            tail[i * stride + p] = std::max(below, right) + jobs[sequence[p] - 1][i];
+        }
+    }
+
+    int workers = std::min(threads, stride);
+    if (workers > 1 && stride * machines_num >= PARALLEL_MIN_CELLS) {
+        std::vector<std::thread> pool;
+        int chunk = (stride + workers - 1) / workers;
+        for (int w = 1; w < workers; ++w) {
+            int from = w * chunk;
+            int to = std::min(stride, from + chunk);
+            if (from < to) {
+                pool.emplace_back(evaluate_positions, std::cref(jobs), machines_num, job, stride, std::ref(workspace),
+                                  from, to);
+            }
+        }
+        evaluate_positions(jobs, machines_num, job, stride, workspace, 0, std::min(chunk, stride));
+        for (std::thread &worker: pool) {
+            worker.join();
+        }
+    } else {
+        evaluate_positions(jobs, machines_num, job, stride, workspace, 0, stride);
+    }
+
+    InsertionResult best = {0, workspace.makespan[0]};
+    int ties = 1;
+    for (int pos = 1; pos < stride; ++pos) {
+        int c_max = workspace.makespan[pos];
+        if (c_max < best.c_max) {
+            best = {pos, c_max};
+            ties = 1;
+        } else if (c_max == best.c_max) {
+            ++ties;
+            if (tie_breaking == NehTieBreaking::last) {
+                best.position = pos;
+            } else if (tie_breaking == NehTieBreaking::random &&
+                       std::uniform_int_distribution<int>(0, ties - 1)(rng) == 0) {
+                best.position = pos;
+            }
+        }
+    }
+    return best;
+}
+
+std::vector<int> neh(const std::vector<std::vector<int>> &jobs, int jobs_num, int machines_num,
+                     const NehOptions &options) {
+    std::vector<int> totals(jobs_num);
+    std::vector<int> priority(jobs_num);
+    for (int j = 0; j < jobs_num; ++j) {
+        totals[j] = std::accumulate(jobs[j].begin(), jobs[j].begin() + machines_num, 0);
+        priority[j] = j + 1;
+    }
+    // decreasing total processing time, ties keep the job numbering
+    std::stable_sort(priority.begin(), priority.end(), [&totals](int a, int b) {
+        return totals[a - 1] > totals[b - 1];
+    });
+
+    std::mt19937 rng(options.seed);
+    TaillardWorkspace workspace;
+    std::vector<int> sequence;
+    sequence.reserve(jobs_num);
+    for (int job: priority) {
+        InsertionResult insertion = taillard_insertion(jobs, machines_num, sequence, job, options.tie_breaking, rng,
+                                                       options.threads, workspace);
+        sequence.insert(sequence.begin() + insertion.position, job);
+    }
+    return sequence;
+}
@@ -0,0 +1,110 @@
+#ifndef NEH_H
+#define NEH_H
+
+#include <vector>
+#include <random>
+
+/**
+ * @brief Tie-breaking rules for choosing between equally good insertion positions.
+ *
+ * - first: The earliest position wins (original NEH).
+ * - last: The latest position wins.
+ * - random: A uniformly random position among the tied ones wins.
+ */
+enum class NehTieBreaking {
+    first,
+    last,
+    random
+};
+
+/**
+ * @brief Struct representing the settings of the NEH heuristic.
+ *
+ * - tie_breaking: The rule applied when several insertion positions give the same makespan.
+ * - threads: The number of threads evaluating insertion positions in parallel.
+ * - seed: The seed of the random tie-breaking rule.
+ */
+struct NehOptions {
+    NehTieBreaking tie_breaking = NehTieBreaking::first;
+    int threads = 1;
+    unsigned seed = 0;
+};
+
+/**
+ * @brief Struct holding the scratch buffers of Taillard's accelerated insertion.
+ *
+ * The buffers are sized on first use and reused afterwards, so repeated insertions
+ * (NEH, insertion local search) do not allocate.
+ *
+ * - head: Completion times of the partial sequence, machine-major (e).
+ * - tail: Tail lengths of the partial sequence, machine-major (q).
+ * - front: Completion times of the inserted job for every insertion position (f).
+ * - makespan: The makespan obtained for every insertion position.
+ */
+struct TaillardWorkspace {
+    std::vector<int> head;
+    std::vector<int> tail;
+    std::vector<int> front;
+    std::vector<int> makespan;
+};
+
+/**
+ * @brief Struct representing the outcome of an insertion.
+ *
+ * - position: The position of the sequence the job should be inserted before.
+ * - c_max: The makespan of the sequence after the insertion.
+ */
+struct InsertionResult {
+    int position;
+    int c_max;
+};
+
+/**
+ * @brief Find the best insertion position of a job using Taillard's acceleration.
+ *
+ * The function evaluates the makespan of inserting the job into every position of
+ * the given partial sequence. With the heads and tails of the partial sequence
+ * precomputed, every position costs O(m), so the whole call runs in O(k * m) for
+ * a sequence of k jobs instead of O(k^2 * m). The positions are evaluated machine by
+ * machine in the SIMD kernels of the selected instruction set, see simd_kernels.h.
+ *
+ * @param jobs A 2D vector representing the processing times of jobs on each machine.
+ * @param machines_num The total number of machines.
+ * @param sequence The partial sequence (1-based job numbers) the job is inserted into.
+ * @param job The job (1-based) to insert.
+ * @param tie_breaking The rule applied to equally good positions.
+ * @param rng The random generator used by the random tie-breaking rule.
+ * @param threads The number of threads evaluating the insertion positions.
+ * @param workspace Scratch buffers reused between calls.
+ *
+ * @return InsertionResult The best position and the resulting makespan.
+ */
+InsertionResult taillard_insertion(const std::vector<std::vector<int>> &jobs,
+                                   int machines_num,
+                                   const std::vector<int> &sequence,
+                                   int job,
+                                   NehTieBreaking tie_breaking,
+                                   std::mt19937 &rng,
+                                   int threads,
+                                   TaillardWorkspace &workspace);
+
+/**
+ * @brief Build a job order with the NEH constructive heuristic.
+ *
+ * The jobs are sorted by decreasing total processing time and inserted one by one
+ * into the position that minimizes the makespan of the partial sequence, found with
+ * taillard_insertion(). The overall complexity is O(n^2 * m).
+ *
+ * @param jobs A 2D vector representing the processing times of jobs on each machine.
+ * @param jobs_num The total number of jobs.
+ * @param machines_num The total number of machines.
+ * @param options The tie-breaking rule, thread count and seed, see NehOptions.
+ *
+ * @return std::vector<int> The constructed job order (1-based job numbers).
+ */
+std::vector<int> neh(const std::vector<std::vector<int>> &jobs,
+                     int jobs_num,
+                     int machines_num,
+                     const NehOptions &options = NehOptions());
+
+#endif // NEH_H
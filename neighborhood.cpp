@@ -0,0 +1,251 @@
+#include "neighborhood.h"
+#include <algorithm>
+#include <utility>
+
+// Blocks are kept short, long blocks behave like a restart rather than a local move
+static const int MAX_BLOCK_LENGTH = 8;
+
+static int uniform(std::mt19937 &rng, int low, int high) {
+    return std::uniform_int_distribution<int>(low, high)(rng);
+}
+
+void apply_move(std::vector<int> &sequence, const Move &move) {
+    std::vector<int>::iterator begin = sequence.begin();
+    if (move.type == MoveType::adjacent_swap || move.type == MoveType::swap) {
+        std::swap(sequence[move.a], sequence[move.b]);
+    } else if (move.type == MoveType::insertion) {
+        if (move.a < move.b) {
+            std::rotate(begin + move.a, begin + move.a + 1, begin + move.b + 1);
+        } else {
+            std::rotate(begin + move.b, begin + move.a, begin + move.a + 1);
+        }
+    } else if (move.type == MoveType::block_move) {
+        if (move.a < move.b) {
+            std::rotate(begin + move.a, begin + move.a + move.length, begin + move.b + move.length);
+        } else {
+            std::rotate(begin + move.b, begin + move.a, begin + move.a + move.length);
+        }
+    } else if (move.type == MoveType::reversal) {
+        std::reverse(begin + move.a, begin + move.b + 1);
+    }
+}
+
+void undo_move(std::vector<int> &sequence, const Move &move) {
+    if (move.type == MoveType::insertion || move.type == MoveType::block_move) {
+        Move inverse = {move.type, move.b, move.a, move.length};
+        apply_move(sequence, inverse);
+    } else {
+        // swaps and reversals are their own inverse
+        apply_move(sequence, move);
+    }
+}
+
+// Operators differ in how they sample and which window they touch, so they share apply/undo
+class WindowMoveOperator : public MoveOperator {
+public:
+    void apply(std::vector<int> &sequence, const Move &move) const override {
+        apply_move(sequence, move);
+    }
+
+    void undo(std::vector<int> &sequence, const Move &move) const override {
+        undo_move(sequence, move);
+    }
+
+    int evaluate(SequenceEvaluator &evaluator, const std::vector<int> &sequence, const Move &move) const override {
+        int removed[4], added[4];
+        int count = evaluator.link_based() ? links(move, removed, added) : 0;
+        if (count > 0) {
+            return evaluator.evaluate_links(sequence, removed, count, added, count);
+        }
+        return evaluator.evaluate(sequence, first(move), last(move));
+    }
+
+protected:
+    /**
+     * @brief List the links a move removes from the order and the links it adds.
+     *
+     * Link p joins positions p and p + 1. Returns the number of links in each list,
+     * 0 if the changed links are not a constant set (the window is evaluated then).
+     */
+    virtual int links(const Move & /*move*/, int * /*removed*/, int * /*added*/) const {
+        return 0;
+    }
+
+    virtual int first(const Move &move) const {
+        return std::min(move.a, move.b);
+    }
+
+    virtual int last(const Move &move) const {
+        return std::max(move.a, move.b);
+    }
+};
+
+// A swap keeps the links between the swapped jobs in place
+static int swap_links(const Move &move, int *removed, int *added) {
+    int low = std::min(move.a, move.b);
+    int high = std::max(move.a, move.b);
+    int count = 0;
+    removed[count++] = low - 1;
+    removed[count++] = low;
+    if (high - 1 > low) {
+        removed[count++] = high - 1;
+    }
+    removed[count++] = high;
+    std::copy(removed, removed + count, added);
+    return count;
+}
+
+class AdjacentSwapOperator : public WindowMoveOperator {
+public:
+    MoveType type() const override { return MoveType::adjacent_swap; }
+
+    Move sample(int jobs_num, std::mt19937 &rng) const override {
+        int a = uniform(rng, 0, jobs_num - 2);
+        return {MoveType::adjacent_swap, a, a + 1, 1};
+    }
+
+protected:
+    int links(const Move &move, int *removed, int *added) const override {
+        return swap_links(move, removed, added);
+    }
+};
+
+class SwapOperator : public WindowMoveOperator {
+public:
+    MoveType type() const override { return MoveType::swap; }
+
+    Move sample(int jobs_num, std::mt19937 &rng) const override {
+        int a = uniform(rng, 0, jobs_num - 1);
+        int b = (a + uniform(rng, 1, jobs_num - 1)) % jobs_num;
+        return {MoveType::swap, a, b, 1};
+    }
+
+protected:
+    int links(const Move &move, int *removed, int *added) const override {
+        return swap_links(move, removed, added);
+    }
+};
+
+// Moving a block (an insertion moves a block of one) cuts three links and joins three
+static int block_links(const Move &move, int *removed, int *added) {
+    int low = std::min(move.a, move.b);
+    int high = std::max(move.a, move.b) + move.length - 1;
+    // the links entering and leaving the span of the move change in both directions
+    removed[0] = low - 1;
+    added[0] = low - 1;
+    removed[1] = move.a < move.b ? move.a + move.length - 1 : move.a - 1;
+    added[1] = move.a < move.b ? move.b - 1 : move.b + move.length - 1;
+    removed[2] = high;
+    added[2] = high;
+    return 3;
+}
+
+class InsertionOperator : public WindowMoveOperator {
+public:
+    MoveType type() const override { return MoveType::insertion; }
+
+    Move sample(int jobs_num, std::mt19937 &rng) const override {
+        int a = uniform(rng, 0, jobs_num - 1);
+        int b = (a + uniform(rng, 1, jobs_num - 1)) % jobs_num;
+        return {MoveType::insertion, a, b, 1};
+    }
+
+protected:
+    int links(const Move &move, int *removed, int *added) const override {
+        return block_links(move, removed, added);
+    }
+};
+
+class BlockMoveOperator : public WindowMoveOperator {
+public:
+    MoveType type() const override { return MoveType::block_move; }
+
+    Move sample(int jobs_num, std::mt19937 &rng) const override {
+        int length = uniform(rng, std::min(2, jobs_num - 1), std::min(MAX_BLOCK_LENGTH, jobs_num - 1));
+        int starts = jobs_num - length + 1;
+        int a = uniform(rng, 0, starts - 1);
+        int b = (a + uniform(rng, 1, starts - 1)) % starts;
+        return {MoveType::block_move, a, b, length};
+    }
+
+protected:
+    int last(const Move &move) const override {
+        return std::max(move.a, move.b) + move.length - 1;
+    }
+
+    int links(const Move &move, int *removed, int *added) const override {
+        return block_links(move, removed, added);
+    }
+};
+
+class ReversalOperator : public WindowMoveOperator {
+public:
+    MoveType type() const override { return MoveType::reversal; }
+
+    Move sample(int jobs_num, std::mt19937 &rng) const override {
+        int a = uniform(rng, 0, jobs_num - 2);
+        int b = uniform(rng, a + 1, jobs_num - 1);
+        return {MoveType::reversal, a, b, 1};
+    }
+};
+
+std::unique_ptr<MoveOperator> make_move_operator(MoveType type) {
+    if (type == MoveType::adjacent_swap) {
+        return std::unique_ptr<MoveOperator>(new AdjacentSwapOperator());
+    } else if (type == MoveType::swap) {
+        return std::unique_ptr<MoveOperator>(new SwapOperator());
+    } else if (type == MoveType::insertion) {
+        return std::unique_ptr<MoveOperator>(new InsertionOperator());
+    } else if (type == MoveType::block_move) {
+        return std::unique_ptr<MoveOperator>(new BlockMoveOperator());
+    }
+    return std::unique_ptr<MoveOperator>(new ReversalOperator());
+}
+
+std::string move_type_name(MoveType type) {
+    std::string name;
+    if (type == MoveType::adjacent_swap) {
+        name = "Adjacent swap";
+    } else if (type == MoveType::swap) {
+        name = "Swap";
+    } else if (type == MoveType::insertion) {
+        name = "Insertion";
+    } else if (type == MoveType::block_move) {
+        name = "Block move";
+    } else if (type == MoveType::reversal) {
+        name = "Reversal";
+    }
+    return name;
+}
+
+AdaptiveOperatorSelector::AdaptiveOperatorSelector(int operators, double min_probability, double decay)
+        : min_probability_(std::min(min_probability, 1.0 / operators)), decay_(decay),
+          quality_(operators, 0.0), probabilities_(operators, 1.0 / operators) {
+}
+
+int AdaptiveOperatorSelector::select(std::mt19937 &rng) const {
+    double r = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    int last = probabilities_.size() - 1;
+    for (int op = 0; op < last; ++op) {
+        r -= probabilities_[op];
+        if (r < 0) {
+            return op;
+        }
+    }
+    return last;
+}
+
+void AdaptiveOperatorSelector::reward(int op, double improvement, double cost) {
+    double credit = std::max(0.0, improvement) / std::max(1.0, cost);
+    quality_[op] += decay_ * (credit - quality_[op]);
+
+    double total = 0;
+    for (double q: quality_) {
+        total += q;
+    }
+    int operators = quality_.size();
+    for (int k = 0; k < operators; ++k) {
+        double share = total > 0 ? quality_[k] / total : 1.0 / operators;
+        probabilities_[k] = min_probability_ + (1.0 - operators * min_probability_) * share;
+    }
+}
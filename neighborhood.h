@@ -0,0 +1,212 @@
+#ifndef NEIGHBORHOOD_H
+#define NEIGHBORHOOD_H
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "sequence_evaluator.h"
+
+/**
+ * @brief Types of neighborhood moves on a job order.
+ *
+ * - adjacent_swap: Swap the jobs at positions a and a + 1.
+ * - swap: Swap the jobs at two distinct positions a and b.
+ * - insertion: Remove the job at position a and insert it so it ends up at position b.
+ * - block_move: Move the block of length jobs starting at position a so it starts at position b.
+ * - reversal: Reverse the jobs between positions a and b (inclusive).
+ */
+enum class MoveType {
+    adjacent_swap,
+    swap,
+    insertion,
+    block_move,
+    reversal
+};
+
+const int MOVE_TYPE_COUNT = 5;
+
+/**
+ * @brief Struct representing one move on a job order.
+ *
+ * The positions are 0-based. length is only used by block moves.
+ */
+struct Move {
+    MoveType type;
+    int a;
+    int b;
+    int length;
+};
+
+/**
+ * @brief Interface of a neighborhood move operator.
+ *
+ * An operator samples non-trivial moves (a move never maps an order onto itself),
+ * applies and undoes them in place, and evaluates the moved order incrementally
+ * from the window of positions the move touched.
+ */
+class MoveOperator {
+public:
+    virtual ~MoveOperator() {}
+
+    virtual MoveType type() const = 0;
+
+    /**
+     * @brief Sample a random non-trivial move for an order of jobs_num jobs (jobs_num >= 2).
+     */
+    virtual Move sample(int jobs_num, std::mt19937 &rng) const = 0;
+
+    /**
+     * @brief Apply the move to the order in place.
+     */
+    virtual void apply(std::vector<int> &sequence, const Move &move) const = 0;
+
+    /**
+     * @brief Undo a move previously applied to the order.
+     */
+    virtual void undo(std::vector<int> &sequence, const Move &move) const = 0;
+
+    /**
+     * @brief Evaluate an order the move was applied to, relative to the evaluator's base order.
+     *
+     * @param evaluator An evaluator whose base order is the order before the move.
+     * @param sequence The order after the move.
+     * @param move The applied move.
+     *
+     * @return int The objective value of the moved order.
+     */
+    virtual int evaluate(SequenceEvaluator &evaluator, const std::vector<int> &sequence, const Move &move) const = 0;
+};
+
+/**
+ * @brief Create the operator of a move type.
+ *
+ * @param type The move type.
+ *
+ * @return std::unique_ptr<MoveOperator> The operator.
+ */
+std::unique_ptr<MoveOperator> make_move_operator(MoveType type);
+
+/**
+ * @brief Apply a move of any type to an order in place.
+ */
+void apply_move(std::vector<int> &sequence, const Move &move);
+
+/**
+ * @brief Undo a move of any type previously applied to an order.
+ */
+void undo_move(std::vector<int> &sequence, const Move &move);
+
+/**
+ * @brief Journal of the moves applied to a job order since a reference point.
+ *
+ * The journal lets a working order be mutated in place: moves are recorded as they
+ * are applied, and the order is brought back to the reference point by undoing them
+ * in reverse. A short move list is also how a remembered order (e.g. the best
+ * neighbor of an epoch) is stored, instead of a full copy of the order.
+ */
+class MoveJournal {
+public:
+    /**
+     * @brief Apply a move to the order and record it.
+     */
+    void apply(std::vector<int> &sequence, const Move &move) {
+        apply_move(sequence, move);
+        moves_.push_back(move);
+    }
+
+    /**
+     * @brief Undo all recorded moves, newest first, and clear the journal.
+     */
+    void rollback(std::vector<int> &sequence) {
+        for (std::vector<Move>::reverse_iterator it = moves_.rbegin(); it != moves_.rend(); ++it) {
+            undo_move(sequence, *it);
+        }
+        moves_.clear();
+    }
+
+    /**
+     * @brief Apply all recorded moves, oldest first, and clear the journal.
+     */
+    void replay(std::vector<int> &sequence) {
+        for (const Move &move: moves_) {
+            apply_move(sequence, move);
+        }
+        moves_.clear();
+    }
+
+    /**
+     * @brief Replace the recorded moves with those of another journal.
+     */
+    void assign(const MoveJournal &other) {
+        moves_.assign(other.moves_.begin(), other.moves_.end());
+    }
+
+    void clear() { moves_.clear(); }
+    bool empty() const { return moves_.empty(); }
+    const std::vector<Move> &moves() const { return moves_; }
+
+private:
+    std::vector<Move> moves_;
+};
+
+/**
+ * @brief Get the name of a move type.
+ *
+ * @param type The move type.
+ *
+ * @return std::string The name of the move type.
+ */
+std::string move_type_name(MoveType type);
+
+/**
+ * @brief Adaptive selection of move operators by credit assignment.
+ *
+ * Every operator keeps a quality estimate, an exponential recency-weighted average
+ * of the improvement it achieved per unit of evaluation cost. Operators are picked
+ * by probability matching: each gets a minimum probability, the rest is shared in
+ * proportion to the quality estimates. Cheap operators that keep improving are
+ * therefore picked more often, without starving the others.
+ */
+class AdaptiveOperatorSelector {
+public:
+    /**
+     * @brief Construct a selector.
+     *
+     * @param operators The number of operators to choose from.
+     * @param min_probability The minimum selection probability of every operator.
+     * @param decay The weight of the latest reward in the quality estimate.
+     */
+    explicit AdaptiveOperatorSelector(int operators, double min_probability = 0.05, double decay = 0.1);
+
+    /**
+     * @brief Pick an operator.
+     *
+     * @param rng The random generator.
+     *
+     * @return int The index of the picked operator.
+     */
+    int select(std::mt19937 &rng) const;
+
+    /**
+     * @brief Credit an operator with the outcome of one of its moves.
+     *
+     * @param op The index of the operator.
+     * @param improvement The decrease of the objective achieved by the move (negative for worse).
+     * @param cost The evaluation cost of the move.
+     */
+    void reward(int op, double improvement, double cost);
+
+    /**
+     * @brief Get the current selection probability of every operator.
+     */
+    const std::vector<double> &probabilities() const { return probabilities_; }
+
+private:
+    double min_probability_;
+    double decay_;
+    std::vector<double> quality_;
+    std::vector<double> probabilities_;
+};
+
+#endif // NEIGHBORHOOD_H
@@ -0,0 +1,132 @@
+#include "no_wait.h"
+#include <algorithm>
+#include <thread>
+#include "deadlines.h"
+
+static const int TILE = 64;
+static const long long PARALLEL_MIN_CELLS = 1 << 20;
+
+// Delay between the starts of two jobs from their cumulative processing times
+template<typename T>
+static T pair_delay(const T *from, const T *to, int machines_num) {
+    T delay = from[0];
+    for (int k = 1; k < machines_num; ++k) {
+        delay = std::max(delay, from[k] - to[k - 1]);
+    }
+    return delay;
+}
+
+DelayMatrix::DelayMatrix(const std::vector<std::vector<int>> &jobs, int jobs_num, int machines_num, int threads)
+        : jobs_num_(jobs_num), delays_(static_cast<std::size_t>(jobs_num) * jobs_num, 0), lengths_(jobs_num, 0) {
+    std::vector<int> cumulative(static_cast<std::size_t>(jobs_num) * machines_num);
+    for (int j = 0; j < jobs_num; ++j) {
+        int sum = 0;
+        for (int k = 0; k < machines_num; ++k) {
+            sum += jobs[j][k];
+            cumulative[j * machines_num + k] = sum;
+        }
+        lengths_[j] = sum;
+    }
+    int tiles = (jobs_num + TILE - 1) / TILE;
+    auto fill = [&](int worker, int workers) {
+        for (int row = worker; row < tiles; row += workers) {
+            int from_end = std::min(jobs_num, (row + 1) * TILE);
+            for (int column = 0; column < tiles; ++column) {
+                int to_end = std::min(jobs_num, (column + 1) * TILE);
+                for (int from = row * TILE; from < from_end; ++from) {
+                    for (int to = column * TILE; to < to_end; ++to) {
+                        delays_[from * jobs_num + to] = pair_delay(&cumulative[from * machines_num],
+                                                                   &cumulative[to * machines_num], machines_num);
+                    }
+                }
+            }
+        }
+    };
+    int workers = std::max(1, std::min(threads, tiles));
+    if (static_cast<long long>(jobs_num) * jobs_num * machines_num < PARALLEL_MIN_CELLS) {
+        workers = 1;
+    }
+    std::vector<std::thread> pool;
+    for (int worker = 1; worker < workers; ++worker) {
+        pool.emplace_back(fill, worker, workers);
+    }
+    fill(0, workers);
+    for (std::thread &thread: pool) {
+        thread.join();
+    }
+}
+
+long long DelayMatrix::makespan(const std::vector<int> &sequence) const {
+    if (sequence.empty()) {
+        return 0;
+    }
+    long long c_max = 0;
+    for (std::size_t p = 0; p + 1 < sequence.size(); ++p) {
+        c_max += delay(sequence[p], sequence[p + 1]);
+    }
+    return c_max + length(sequence.back());
+}
+
+int no_wait_delay(const std::vector<std::vector<int>> &jobs, int machines_num, int from, int to) {
+    const std::vector<int> &before = jobs[from - 1];
+    const std::vector<int> &after = jobs[to - 1];
+    int finished = before[0];  // P_from(k)
+    int started = 0;           // P_to(k - 1)
+    int delay = finished;
+    for (int k = 1; k < machines_num; ++k) {
+        finished += before[k];
+        started += after[k - 1];
+        delay = std::max(delay, finished - started);
+    }
+    return delay;
+}
+
+long long no_wait_makespan(const std::vector<std::vector<int>> &jobs, int machines_num,
+                           const std::vector<int> &sequence) {
+    if (sequence.empty()) {
+        return 0;
+    }
+    std::vector<long long> from(machines_num), to(machines_num);
+    long long sum = 0;
+    for (int k = 0; k < machines_num; ++k) {
+        sum += jobs[sequence[0] - 1][k];
+        to[k] = sum;
+    }
+    long long c_max = 0;
+    for (std::size_t p = 1; p < sequence.size(); ++p) {
+        from.swap(to);
+        sum = 0;
+        for (int k = 0; k < machines_num; ++k) {
+            sum += jobs[sequence[p] - 1][k];
+            to[k] = sum;
+        }
+        c_max += pair_delay(from.data(), to.data(), machines_num);
+    }
+    return c_max + to[machines_num - 1];
+}
+
+ObjectFunctionResult no_wait_object_function(const std::vector<std::vector<int>> &jobs,
+                                             const std::vector<int> &order, int jobs_num, int machines_num,
+                                             const std::vector<int> &deadlines) {
+    std::vector<std::vector<int>> job_begin(machines_num, std::vector<int>(jobs_num, 0));
+    std::vector<std::vector<int>> job_end(machines_num, std::vector<int>(jobs_num, 0));
+    int start = 0;
+    for (int j = 0; j < jobs_num; ++j) {
+        if (j > 0) {
+            // the earliest start that keeps every machine free when the job reaches it
+            for (int i = 0, before = 0; i < machines_num; ++i) {
+                start = std::max(start, job_end[i][j - 1] - before);
+                before += jobs[order[j] - 1][i];
+            }
+        }
+        int time = start;
+        for (int i = 0; i < machines_num; ++i) {
+            job_begin[i][j] = time;
+            time += jobs[order[j] - 1][i];
+            job_end[i][j] = time;
+        }
+    }
+    int c_max = jobs_num > 0 ? job_end[machines_num - 1][jobs_num - 1] : 0;
+    int t_sum = calculate_deadlines(jobs, job_end, deadlines, order).t_sum;
+    return {c_max, t_sum, job_begin, job_end};
+}
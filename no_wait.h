@@ -0,0 +1,103 @@
+#ifndef NO_WAIT_H
+#define NO_WAIT_H
+
+#include <vector>
+#include "simulated_annealing.h"
+
+/**
+ * @brief Matrix of the start delays between consecutive jobs of a no-wait flow shop.
+ *
+ * In a no-wait flow shop a job runs through all machines without waiting, so the
+ * start of a job only depends on the start of the job before it. The delay
+ * d(i, j) = max over machines k of (P_i(k) - P_j(k - 1)), with P the cumulative
+ * processing times of a job, is the smallest distance between the starts of job i
+ * and a directly following job j. The makespan of an order is the sum of the delays
+ * between its consecutive jobs plus the total processing time of its last job.
+ */
+class DelayMatrix {
+public:
+    /**
+     * @brief Precompute the delays of every pair of jobs.
+     *
+     * The matrix is filled in square tiles, so the cumulative processing times of a
+     * tile stay in the cache; the rows of tiles are shared among the threads.
+     *
+     * @param jobs A 2D vector representing the processing times of jobs on each machine.
+     * @param jobs_num The total number of jobs.
+     * @param machines_num The total number of machines.
+     * @param threads The number of threads filling the matrix, used for large instances only.
+     */
+    DelayMatrix(const std::vector<std::vector<int>> &jobs, int jobs_num, int machines_num, int threads = 1);
+
+    /**
+     * @brief Get the delay between the starts of job from and a directly following job to (1-based).
+     */
+    int delay(int from, int to) const { return delays_[(from - 1) * jobs_num_ + to - 1]; }
+
+    /**
+     * @brief Get the total processing time of a job (1-based).
+     */
+    int length(int job) const { return lengths_[job - 1]; }
+
+    /**
+     * @brief Calculate the no-wait makespan of an order in a single pass.
+     *
+     * @param sequence The job order (1-based job numbers), may be a partial order.
+     *
+     * @return long long The makespan, 0 for an empty order.
+     */
+    long long makespan(const std::vector<int> &sequence) const;
+
+    int jobs_num() const { return jobs_num_; }
+
+private:
+    int jobs_num_;
+    std::vector<int> delays_;   // row-major, delays_[(from - 1) * n + to - 1]
+    std::vector<int> lengths_;
+};
+
+/**
+ * @brief Calculate the delay between the starts of two consecutive jobs (1-based) in O(m).
+ */
+int no_wait_delay(const std::vector<std::vector<int>> &jobs, int machines_num, int from, int to);
+
+/**
+ * @brief Calculate the no-wait makespan of an order without a delay matrix.
+ *
+ * Every delay is computed on the fly in O(m), which is cheaper than building a
+ * matrix for a single evaluation. The makespan is computed in 64 bits, so it is
+ * exact for any instance.
+ *
+ * @param jobs A 2D vector representing the processing times of jobs on each machine.
+ * @param machines_num The total number of machines.
+ * @param sequence The job order (1-based job numbers), may be a partial order.
+ *
+ * @return long long The makespan, 0 for an empty order.
+ */
+long long no_wait_makespan(const std::vector<std::vector<int>> &jobs,
+                           int machines_num,
+                           const std::vector<int> &sequence);
+
+/**
+ * @brief Calculate the schedule of an order in a no-wait flow shop.
+ *
+ * The counterpart of object_function() for the no-wait variant: every job starts
+ * as early as the delays to the job before it allow and then runs through the
+ * machines without waiting.
+ *
+ * @param jobs A 2D vector representing the processing times of jobs on each machine.
+ * @param order A vector specifying the order in which jobs are processed.
+ * @param jobs_num An integer representing the total number of jobs.
+ * @param machines_num An integer representing the total number of machines.
+ * @param deadlines A vector representing the deadlines for each job.
+ *
+ * @return ObjectFunctionResult The no-wait makespan, total tardiness and the start
+ * and end times of the jobs on each machine.
+ */
+ObjectFunctionResult no_wait_object_function(const std::vector<std::vector<int>> &jobs,
+                                             const std::vector<int> &order,
+                                             int jobs_num,
+                                             int machines_num,
+                                             const std::vector<int> &deadlines);
+
+#endif // NO_WAIT_H
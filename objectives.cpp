@@ -0,0 +1,208 @@
+#include "objectives.h"
+#include "no_wait.h"
+#include "setup_times.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <sstream>
+
+const std::vector<ObjectiveInfo> &objective_registry() {
+    static const std::vector<ObjectiveInfo> registry = {
+            {Objective::c_max, "c_max", "makespan", false},
+            {Objective::t_sum, "t_sum", "total tardiness", true},
+            {Objective::no_wait_c_max, "no_wait_c_max", "makespan of a no-wait flow shop", false},
+            {Objective::flowtime, "flowtime", "total completion time", false},
+            {Objective::weighted_tardiness, "weighted_tardiness", "total tardiness times the job weights", true},
+            {Objective::max_lateness, "max_lateness", "largest lateness of a job", true},
+            {Objective::tardy_jobs, "tardy_jobs", "number of jobs finished after their deadline", true},
+            {Objective::weighted_sum, "weighted_sum", "weighted combination of the criteria", true},
+    };
+    return registry;
+}
+
+const ObjectiveInfo &objective_info(Objective objective) {
+    return objective_registry()[static_cast<int>(objective)];
+}
+
+bool parse_objective(const std::string &name, Objective &objective) {
+    for (const ObjectiveInfo &info: objective_registry()) {
+        if (info.name == name) {
+            objective = info.objective;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parse_criteria_weights(const std::string &text, CriteriaWeights &weights) {
+    weights = CriteriaWeights();
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        std::size_t colon = item.find(':');
+        if (colon == std::string::npos || colon + 1 == item.size()) {
+            return false;
+        }
+        std::string name = item.substr(0, colon);
+        char *end = nullptr;
+        long coefficient = std::strtol(item.c_str() + colon + 1, &end, 10);
+        // a negative coefficient would reward a criterion and break the lower bounds of the objective
+        if (*end != '\0' || coefficient < 0 || coefficient > INT_MAX) {
+            return false;
+        }
+        int value = static_cast<int>(coefficient);
+        if (name == "c_max") {
+            weights.c_max = value;
+        } else if (name == "t_sum") {
+            weights.t_sum = value;
+        } else if (name == "flowtime") {
+            weights.flowtime = value;
+        } else if (name == "weighted_tardiness") {
+            weights.weighted_tardiness = value;
+        } else if (name == "max_lateness") {
+            weights.max_lateness = value;
+        } else if (name == "tardy_jobs") {
+            weights.tardy_jobs = value;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+CriteriaWeights criteria_weights(Objective objective, const CriteriaWeights &combination) {
+    CriteriaWeights weights;
+    switch (objective) {
+        case Objective::c_max:
+        case Objective::no_wait_c_max:
+            weights.c_max = 1;
+            break;
+        case Objective::t_sum:
+            weights.t_sum = 1;
+            break;
+        case Objective::flowtime:
+            weights.flowtime = 1;
+            break;
+        case Objective::weighted_tardiness:
+            weights.weighted_tardiness = 1;
+            break;
+        case Objective::max_lateness:
+            weights.max_lateness = 1;
+            break;
+        case Objective::tardy_jobs:
+            weights.tardy_jobs = 1;
+            break;
+        case Objective::weighted_sum:
+            weights = combination;
+            break;
+    }
+    return weights;
+}
+
+bool has_criteria(const CriteriaWeights &weights) {
+    return weights.c_max != 0 || weights.t_sum != 0 || weights.flowtime != 0 || weights.weighted_tardiness != 0 ||
+           weights.max_lateness != 0 || weights.tardy_jobs != 0;
+}
+
+int trivial_lower_bound(Objective objective, const CriteriaWeights &combination) {
+    return criteria_weights(objective, combination).max_lateness != 0 ? INT_MIN : 0;
+}
+
+int combine_criteria(const CriteriaValues &values, const CriteriaWeights &weights) {
+    return checked_value(static_cast<long long>(weights.c_max) * values.c_max +
+                         static_cast<long long>(weights.t_sum) * values.t_sum +
+                         static_cast<long long>(weights.flowtime) * values.flowtime +
+                         static_cast<long long>(weights.weighted_tardiness) * values.weighted_tardiness +
+                         static_cast<long long>(weights.max_lateness) * values.max_lateness +
+                         static_cast<long long>(weights.tardy_jobs) * values.tardy_jobs);
+}
+
+CriteriaValues schedule_criteria(const std::vector<std::vector<int>> &job_end, const std::vector<int> &order,
+                                 const std::vector<int> &deadlines, const std::vector<int> &job_weights) {
+    CriteriaValues values;
+    if (job_end.empty() || order.empty()) {
+        return values;
+    }
+    // the sums are accumulated in 64 bits, only the totals have to fit into an int
+    const std::vector<int> &last_machine = job_end.back();
+    long long c_max = 0, t_sum = 0, flowtime = 0, weighted_tardiness = 0, max_lateness = LLONG_MIN;
+    for (std::size_t p = 0; p < order.size(); ++p) {
+        int job = order[p] - 1;
+        long long completion = last_machine[p];
+        int deadline = job < static_cast<int>(deadlines.size()) ? deadlines[job] : 0;
+        int weight = job < static_cast<int>(job_weights.size()) ? job_weights[job] : 1;
+        long long tardiness = std::max(0LL, completion - deadline);
+        c_max = std::max(c_max, completion);
+        t_sum += tardiness;
+        flowtime += completion;
+        weighted_tardiness += weight * tardiness;
+        max_lateness = std::max(max_lateness, completion - deadline);
+        values.tardy_jobs += tardiness > 0 ? 1 : 0;
+    }
+    values.c_max = checked_value(c_max);
+    values.t_sum = checked_value(t_sum);
+    values.flowtime = checked_value(flowtime);
+    values.weighted_tardiness = checked_value(weighted_tardiness);
+    values.max_lateness = checked_value(max_lateness);
+    return values;
+}
+
+// The processing times of a job in the completion-time type, the 32-bit kernel reads them in place
+static const int *job_row(const std::vector<int> &times, std::vector<int> &) {
+    return times.data();
+}
+
+template<typename T>
+static const T *job_row(const std::vector<int> &times, std::vector<T> &buffer) {
+    buffer.assign(times.begin(), times.end());
+    return buffer.data();
+}
+
+// The fused pass in the completion-time type T, state and processing are scratch space
+template<typename T>
+static long long fused_value(const std::vector<std::vector<int>> &jobs, int machines_num,
+                             const std::vector<int> &deadlines, const SetupTimes *setups,
+                             const std::vector<int> &job_weights, const CriteriaWeights &weights,
+                             const std::vector<int> &sequence, std::vector<T> &state, std::vector<T> &processing) {
+    state.assign(machines_num, 0);
+    long long additive = 0;
+    long long max_lateness = LLONG_MIN;
+    long long c = 0;
+    for (std::size_t p = 0; p < sequence.size(); ++p) {
+        int job = sequence[p] - 1;
+        const int *setup = setups != nullptr && p > 0 ? setups->row(sequence[p - 1], sequence[p]) : nullptr;
+        c = append_job(job_row(jobs[job], processing), setup, machines_num, state.data());
+        int deadline = job < static_cast<int>(deadlines.size()) ? deadlines[job] : 0;
+        int weight = job < static_cast<int>(job_weights.size()) ? job_weights[job] : 1;
+        additive += additive_criteria(weights, c, deadline, weight);
+        max_lateness = std::max(max_lateness, c - deadline);
+    }
+    long long value = additive + weights.c_max * c;
+    if (weights.max_lateness != 0 && !sequence.empty()) {
+        value += weights.max_lateness * max_lateness;
+    }
+    return value;
+}
+
+int evaluate_order(const std::vector<std::vector<int>> &jobs, int machines_num, const std::vector<int> &deadlines,
+                   Objective objective, const ObjectiveContext *context, const std::vector<int> &sequence,
+                   std::vector<int> &state) {
+    if (objective == Objective::no_wait_c_max) {
+        return checked_value(no_wait_makespan(jobs, machines_num, sequence));
+    }
+    static const std::vector<int> no_weights;
+    static const CriteriaWeights no_combination;
+    const SetupTimes *setups = context != nullptr ? context->setups : nullptr;
+    const std::vector<int> &job_weights = context != nullptr ? context->job_weights : no_weights;
+    CriteriaWeights weights = criteria_weights(objective, context != nullptr ? context->combination : no_combination);
+
+    // one pass computes the completion times and accumulates every weighted criterion
+    if (context == nullptr || context->width == TimeWidth::w64) {
+        std::vector<int64_t> wide_state, wide_processing;
+        return checked_value(fused_value(jobs, machines_num, deadlines, setups, job_weights, weights, sequence,
+                                         wide_state, wide_processing));
+    }
+    std::vector<int> unused;  // the 32-bit kernel needs no copy of the processing times
+    return checked_value(fused_value(jobs, machines_num, deadlines, setups, job_weights, weights, sequence, state,
+                                     unused));
+}
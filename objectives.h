@@ -0,0 +1,223 @@
+#ifndef OBJECTIVES_H
+#define OBJECTIVES_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "time_width.h"
+
+class DelayMatrix;
+
+/**
+ * @brief Objectives the annealing engine can minimize.
+ *
+ * - c_max: The makespan of the schedule.
+ * - t_sum: The total tardiness of the jobs.
+ * - no_wait_c_max: The makespan of the schedule in a no-wait flow shop, see DelayMatrix.
+ * - flowtime: The total completion time of the jobs.
+ * - weighted_tardiness: The total tardiness of the jobs, each weighted by its job weight.
+ * - max_lateness: The largest lateness (completion time minus deadline) of any job.
+ * - tardy_jobs: The number of jobs that finish after their deadline.
+ * - weighted_sum: A weighted combination of the criteria above, see CriteriaWeights.
+ */
+enum class Objective {
+    c_max,
+    t_sum,
+    no_wait_c_max,
+    flowtime,
+    weighted_tardiness,
+    max_lateness,
+    tardy_jobs,
+    weighted_sum
+};
+
+/**
+ * @brief Struct representing the coefficients of the criteria of a schedule.
+ *
+ * A single objective has a coefficient of 1 for its own criterion; weighted_sum
+ * minimizes the sum of every criterion times its coefficient.
+ */
+struct CriteriaWeights {
+    int c_max = 0;
+    int t_sum = 0;
+    int flowtime = 0;
+    int weighted_tardiness = 0;
+    int max_lateness = 0;
+    int tardy_jobs = 0;
+};
+
+/**
+ * @brief Struct representing the value of every criterion of a schedule.
+ */
+struct CriteriaValues {
+    int c_max = 0;
+    int t_sum = 0;
+    int flowtime = 0;
+    int weighted_tardiness = 0;
+    int max_lateness = 0;
+    int tardy_jobs = 0;
+};
+
+/**
+ * @brief Struct representing the instance data the objectives need besides the jobs.
+ *
+ * - setups: Optional sequence-dependent setup times, must outlive the users of the context.
+ * - job_weights: The weight of every job in the weighted tardiness; missing weights are 1.
+ * - combination: The coefficients of Objective::weighted_sum.
+ * - width: The width the completion times of the instance fit into, see
+ *   choose_time_width(); the default is safe for any instance.
+ * - delays: Optional delay matrix of the instance for the no-wait objective, shared by
+ *   the evaluators of a run so it is built once; without it every evaluator builds its own.
+ */
+struct ObjectiveContext {
+    const SetupTimes *setups = nullptr;
+    std::vector<int> job_weights;
+    CriteriaWeights combination;
+    TimeWidth width = TimeWidth::w64;
+    std::shared_ptr<const DelayMatrix> delays;
+};
+
+/**
+ * @brief Struct describing an objective of the registry.
+ *
+ * - objective: The objective.
+ * - name: The name used on the command line and in sweep specifications.
+ * - description: A short description for listings.
+ * - due_dates: True if the objective depends on the deadlines, which makes the
+ *   due-date rules better start orders than NEH.
+ */
+struct ObjectiveInfo {
+    Objective objective;
+    std::string name;
+    std::string description;
+    bool due_dates;
+};
+
+/**
+ * @brief Get the registry of every objective, in the order of the Objective enum.
+ */
+const std::vector<ObjectiveInfo> &objective_registry();
+
+/**
+ * @brief Get the registry entry of an objective.
+ */
+const ObjectiveInfo &objective_info(Objective objective);
+
+/**
+ * @brief Parse the name of an objective.
+ *
+ * @param name A name of the registry, e.g. "c_max" or "weighted_tardiness".
+ * @param objective Output for the parsed objective.
+ *
+ * @return bool True if the name is known.
+ */
+bool parse_objective(const std::string &name, Objective &objective);
+
+/**
+ * @brief Parse the coefficients of a weighted combination.
+ *
+ * @param text A comma-separated list of name:coefficient pairs, e.g. "c_max:2,t_sum:1".
+ * @param weights Output for the coefficients; criteria not listed are 0.
+ *
+ * @return bool True if every pair names a criterion and has a non-negative integer coefficient.
+ */
+bool parse_criteria_weights(const std::string &text, CriteriaWeights &weights);
+
+/**
+ * @brief Check whether a combination has any nonzero coefficient; weighted_sum needs one.
+ */
+bool has_criteria(const CriteriaWeights &weights);
+
+/**
+ * @brief Get the coefficients an objective minimizes.
+ *
+ * @param objective The objective; the no-wait makespan counts as the makespan.
+ * @param combination The coefficients returned for Objective::weighted_sum.
+ *
+ * @return CriteriaWeights The coefficients.
+ */
+CriteriaWeights criteria_weights(Objective objective, const CriteriaWeights &combination);
+
+/**
+ * @brief Get the lower bound every order of an objective reaches.
+ *
+ * Zero, unless the objective weights the maximum lateness, which is negative when
+ * every job is early; then there is no trivial bound and INT_MIN is returned.
+ */
+int trivial_lower_bound(Objective objective, const CriteriaWeights &combination);
+
+/**
+ * @brief Get the share of one job in the criteria that are sums over the jobs.
+ *
+ * Total tardiness, flowtime, weighted tardiness and the tardy jobs all add up a
+ * term per job, so a prefix of an order can carry their weighted sum.
+ *
+ * @param weights The coefficients of the criteria.
+ * @param completion The completion time of the job on the last machine.
+ * @param deadline The deadline of the job.
+ * @param job_weight The weight of the job in the weighted tardiness.
+ *
+ * @return long long The weighted share of the job.
+ */
+inline long long additive_criteria(const CriteriaWeights &weights, long long completion, int deadline,
+                                   int job_weight) {
+    long long tardiness = completion > deadline ? completion - deadline : 0;
+    return weights.t_sum * tardiness + weights.flowtime * completion +
+           static_cast<long long>(weights.weighted_tardiness) * job_weight * tardiness +
+           weights.tardy_jobs * (tardiness > 0 ? 1 : 0);
+}
+
+/**
+ * @brief Combine the criteria of a schedule into an objective value.
+ *
+ * @throws std::overflow_error If the value does not fit into an int.
+ */
+int combine_criteria(const CriteriaValues &values, const CriteriaWeights &weights);
+
+/**
+ * @brief Calculate every criterion of a schedule from the completion times of its jobs.
+ *
+ * @param job_end A 2D matrix representing the end times of each job on each machine.
+ * @param order The job order (1-based job numbers).
+ * @param deadlines A vector representing the deadlines for each job.
+ * @param job_weights The weights of the jobs; missing weights are 1.
+ *
+ * @return CriteriaValues The value of every criterion.
+ *
+ * @throws std::overflow_error If a criterion does not fit into an int.
+ */
+CriteriaValues schedule_criteria(const std::vector<std::vector<int>> &job_end,
+                                 const std::vector<int> &order,
+                                 const std::vector<int> &deadlines,
+                                 const std::vector<int> &job_weights);
+
+/**
+ * @brief Evaluate an objective on a job order in one fused pass.
+ *
+ * The completion times and every criterion the objective weights are computed in
+ * the same pass over the order, which may be partial (e.g. during a constructive
+ * heuristic). The no-wait makespan is summed from the delays instead, in 64 bits. The
+ * completion times are computed in 64 bits when the width of the context says so,
+ * otherwise in 32 bits; the criteria are always accumulated in 64 bits.
+ *
+ * @param jobs A 2D vector representing the processing times of jobs on each machine.
+ * @param machines_num The total number of machines.
+ * @param deadlines A vector representing the deadlines for each job.
+ * @param objective The objective.
+ * @param context Optional setups, job weights and combination, may be nullptr.
+ * @param sequence The job order (1-based job numbers).
+ * @param state Scratch buffer for the machine completion times.
+ *
+ * @return int The objective value of the order.
+ *
+ * @throws std::overflow_error If the value does not fit into an int.
+ */
+int evaluate_order(const std::vector<std::vector<int>> &jobs,
+                   int machines_num,
+                   const std::vector<int> &deadlines,
+                   Objective objective,
+                   const ObjectiveContext *context,
+                   const std::vector<int> &sequence,
+                   std::vector<int> &state);
+
+#endif // OBJECTIVES_H
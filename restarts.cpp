@@ -0,0 +1,105 @@
+#include "restarts.h"
+#include "neh.h"
+#include "neighborhood.h"
+#include "tardiness_seeds.h"
+#include <algorithm>
+
+static const int TARDINESS_RULE_COUNT = 5;
+
+ElitePool::ElitePool(int capacity) : capacity_(std::max(1, capacity)) {
+}
+
+bool ElitePool::offer(const std::vector<int> &order, int value) {
+    int worst = -1;
+    for (int k = 0; k < size(); ++k) {
+        if (values_[k] == value && orders_[k] == order) {
+            return false;
+        }
+        if (worst < 0 || values_[k] > values_[worst]) {
+            worst = k;
+        }
+    }
+    if (size() < capacity_) {
+        orders_.push_back(order);
+        values_.push_back(value);
+        return true;
+    }
+    if (value >= values_[worst]) {
+        return false;
+    }
+    orders_[worst] = order;
+    values_[worst] = value;
+    return true;
+}
+
+const std::vector<int> &ElitePool::pick(std::mt19937 &rng) const {
+    return orders_[std::uniform_int_distribution<int>(0, size() - 1)(rng)];
+}
+
+// Random insertion moves: small enough to stay near the start order, large enough to leave its basin
+static void kick(std::vector<int> &order, int moves, std::mt19937 &rng) {
+    int n = order.size();
+    if (n < 2) {
+        return;
+    }
+    std::uniform_int_distribution<int> position(0, n - 1);
+    for (int k = 0; k < moves; ++k) {
+        int a = position(rng);
+        int b = position(rng);
+        if (a != b) {
+            apply_move(order, {MoveType::insertion, a, b, 1});
+        }
+    }
+}
+
+std::vector<int> restart_order(RestartStrategy strategy, Objective objective,
+                               const std::vector<std::vector<int>> &jobs, int jobs_num, int machines_num,
+                               const std::vector<int> &deadlines, const std::vector<int> &best,
+                               const ElitePool &elite, int restart, int kick_moves, std::mt19937 &rng) {
+    std::vector<int> order;
+    if (strategy == RestartStrategy::elite && !elite.empty()) {
+        order = elite.pick(rng);
+    } else if (strategy == RestartStrategy::constructive && !objective_info(objective).due_dates) {
+        NehOptions options;
+        options.tie_breaking = NehTieBreaking::random;
+        options.seed = rng();
+        order = neh(jobs, jobs_num, machines_num, options);
+    } else if (strategy == RestartStrategy::constructive) {
+        TardinessWorkspace workspace;
+        order = tardiness_seed(static_cast<TardinessRule>(restart % TARDINESS_RULE_COUNT), jobs, jobs_num,
+                               machines_num, deadlines, workspace);
+    } else {
+        order = best;
+    }
+    kick(order, kick_moves > 0 ? kick_moves : std::max(2, jobs_num / 10), rng);
+    return order;
+}
+
+bool parse_restart_strategy(const std::string &name, RestartStrategy &strategy) {
+    if (name == "none") {
+        strategy = RestartStrategy::none;
+    } else if (name == "perturb") {
+        strategy = RestartStrategy::perturb;
+    } else if (name == "elite") {
+        strategy = RestartStrategy::elite;
+    } else if (name == "constructive") {
+        strategy = RestartStrategy::constructive;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string restart_strategy_name(RestartStrategy strategy) {
+    std::string name;
+    if (strategy == RestartStrategy::none) {
+        name = "none";
+    } else if (strategy == RestartStrategy::perturb) {
+        name = "perturb";
+    } else if (strategy == RestartStrategy::elite) {
+        name = "elite";
+    } else if (strategy == RestartStrategy::constructive) {
+        name = "constructive";
+    }
+    return name;
+}
@@ -0,0 +1,144 @@
+#ifndef RESTARTS_H
+#define RESTARTS_H
+
+#include <random>
+#include <string>
+#include <vector>
+#include "sequence_evaluator.h"
+
+/**
+ * @brief Where a stagnated search restarts from.
+ *
+ * - none: Never restart.
+ * - perturb: The global best order after a kick of random insertion moves.
+ * - elite: A random order of the elite pool after a kick.
+ * - constructive: A fresh constructive order: NEH with random tie-breaking for the
+ *   objectives without due dates, the tardiness rules in turn for those with due
+ *   dates (see ObjectiveInfo), both after a kick.
+ */
+enum class RestartStrategy {
+    none,
+    perturb,
+    elite,
+    constructive
+};
+
+/**
+ * @brief Struct representing the settings of stagnation detection and restarts.
+ *
+ * The search has stagnated when the global best has not improved for
+ * stagnation_epochs epochs, or when fewer than min_acceptance of the neighbors of an
+ * epoch were accepted. Either test is disabled by a value of 0.
+ *
+ * - strategy: Where the search restarts from, see RestartStrategy.
+ * - stagnation_epochs: The number of epochs without a new global best.
+ * - min_acceptance: The acceptance ratio of an epoch below which the search is frozen.
+ * - kick_moves: The number of random insertion moves of a kick, 0 uses max(2, n / 10).
+ * - elite_size: The number of distinct good orders kept by the elite pool.
+ */
+struct RestartOptions {
+    RestartStrategy strategy = RestartStrategy::none;
+    int stagnation_epochs = 0;
+    double min_acceptance = 0;
+    int kick_moves = 0;
+    int elite_size = 8;
+};
+
+/**
+ * @brief Struct representing one restart in the telemetry of a run.
+ *
+ * - evaluation: The number of neighbors evaluated before the restart.
+ * - epoch: The epoch after which the search restarted.
+ * - strategy: The restart strategy.
+ * - best_before: The global best value at the restart.
+ * - start_value: The value of the order the search restarted from.
+ * - best_after: The best value the search reached before the next restart or the end.
+ */
+struct RestartEvent {
+    long long evaluation;
+    int epoch;
+    RestartStrategy strategy;
+    int best_before;
+    int start_value;
+    int best_after;
+};
+
+/**
+ * @brief Pool of the best distinct job orders found by a run.
+ */
+class ElitePool {
+public:
+    /**
+     * @brief Construct a pool of at most capacity orders.
+     */
+    explicit ElitePool(int capacity);
+
+    /**
+     * @brief Offer an order to the pool.
+     *
+     * The order is kept if it is not in the pool yet and the pool is not full or the
+     * order is better than the worst order in the pool, which it then replaces.
+     *
+     * @return bool True if the order was kept.
+     */
+    bool offer(const std::vector<int> &order, int value);
+
+    /**
+     * @brief Pick a random order of the pool, which must not be empty.
+     */
+    const std::vector<int> &pick(std::mt19937 &rng) const;
+
+    bool empty() const { return orders_.empty(); }
+    int size() const { return static_cast<int>(orders_.size()); }
+
+private:
+    int capacity_;
+    std::vector<std::vector<int>> orders_;
+    std::vector<int> values_;
+};
+
+/**
+ * @brief Build the order a stagnated search restarts from.
+ *
+ * @param strategy The restart strategy, not RestartStrategy::none.
+ * @param objective The objective of the run.
+ * @param jobs A 2D vector representing the processing times of jobs on each machine.
+ * @param jobs_num The total number of jobs.
+ * @param machines_num The total number of machines.
+ * @param deadlines A vector representing the deadlines for each job.
+ * @param best The global best order.
+ * @param elite The elite pool; the global best is used while it is empty.
+ * @param restart The number of restarts so far, picks the tardiness rule.
+ * @param kick_moves The number of random insertion moves of the kick.
+ * @param rng The random generator of the run.
+ *
+ * @return std::vector<int> The restart order.
+ */
+std::vector<int> restart_order(RestartStrategy strategy,
+                               Objective objective,
+                               const std::vector<std::vector<int>> &jobs,
+                               int jobs_num,
+                               int machines_num,
+                               const std::vector<int> &deadlines,
+                               const std::vector<int> &best,
+                               const ElitePool &elite,
+                               int restart,
+                               int kick_moves,
+                               std::mt19937 &rng);
+
+/**
+ * @brief Parse the name of a restart strategy.
+ *
+ * @param name "none", "perturb", "elite" or "constructive".
+ * @param strategy Output for the parsed strategy.
+ *
+ * @return bool True if the name is known.
+ */
+bool parse_restart_strategy(const std::string &name, RestartStrategy &strategy);
+
+/**
+ * @brief Get the name of a restart strategy.
+ */
+std::string restart_strategy_name(RestartStrategy strategy);
+
+#endif // RESTARTS_H
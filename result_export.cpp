@@ -0,0 +1,232 @@
+#include "result_export.h"
+#include "text_buffer.h"
+#include <algorithm>
+#include <cstdint>
+
+static const char CSV_HEADER[] = "objective,instance,jobs,machines,iterations,neighbors,cooling_strategy,t0,seed,"
+                                 "evaluations,runtime_seconds,value,c_max,t_sum,flowtime,weighted_tardiness,"
+                                 "max_lateness,tardy_jobs,order,completion,lateness,tardiness\n";
+
+ResultRecord make_result_record(const RunMetadata &metadata, const std::vector<int> &order, int value,
+                                const CriteriaValues &criteria, const Deadlines &deadlines) {
+    return {metadata, order, value, criteria, deadlines.end_times, deadlines.jobs_l, deadlines.jobs_t};
+}
+
+static const int RECORD_CRITERIA = 7;
+
+// The value and the criteria of a record, in the order of the CSV columns and the binary fields
+static void criteria_fields(const ResultRecord &record, int *fields) {
+    const CriteriaValues &criteria = record.criteria;
+    const int values[RECORD_CRITERIA] = {record.value, criteria.c_max, criteria.t_sum, criteria.flowtime,
+                                         criteria.weighted_tardiness, criteria.max_lateness, criteria.tardy_jobs};
+    std::copy(values, values + RECORD_CRITERIA, fields);
+}
+
+// Names are written verbatim, only quotes, backslashes and control characters need escaping
+static void append_json_string(std::string &buffer, const std::string &value) {
+    buffer += '"';
+    for (char ch: value) {
+        if (ch == '"' || ch == '\\') {
+            buffer += '\\';
+            buffer += ch;
+        } else if (static_cast<unsigned char>(ch) < 0x20) {
+            buffer += ' ';
+        } else {
+            buffer += ch;
+        }
+    }
+    buffer += '"';
+}
+
+static void append_list(std::string &buffer, const std::vector<int> &values, char separator) {
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (i > 0) {
+            buffer += separator;
+        }
+        append_int(buffer, values[i]);
+    }
+}
+
+static void append_jsonl(std::string &buffer, const ResultRecord &record) {
+    const RunMetadata &meta = record.metadata;
+    buffer += "{\"objective\":";
+    append_json_string(buffer, meta.objective);
+    buffer += ",\"instance\":";
+    append_json_string(buffer, meta.instance);
+    buffer += ",\"jobs\":";
+    append_int(buffer, meta.jobs_num);
+    buffer += ",\"machines\":";
+    append_int(buffer, meta.machines_num);
+    buffer += ",\"iterations\":";
+    append_int(buffer, meta.iterations);
+    buffer += ",\"neighbors\":";
+    append_int(buffer, meta.neighbors);
+    buffer += ",\"cooling_strategy\":";
+    append_int(buffer, meta.cooling_strategy);
+    buffer += ",\"t0\":";
+    append_int(buffer, meta.t0);
+    buffer += ",\"seed\":";
+    append_int(buffer, meta.seed);
+    buffer += ",\"evaluations\":";
+    append_int(buffer, meta.evaluations);
+    buffer += ",\"runtime_seconds\":";
+    append_fixed(buffer, meta.runtime_seconds, 6);
+    static const char *const names[RECORD_CRITERIA] = {"value", "c_max", "t_sum", "flowtime",
+                                                       "weighted_tardiness", "max_lateness", "tardy_jobs"};
+    int fields[RECORD_CRITERIA];
+    criteria_fields(record, fields);
+    for (int k = 0; k < RECORD_CRITERIA; ++k) {
+        buffer += ",\"";
+        buffer += names[k];
+        buffer += "\":";
+        append_int(buffer, fields[k]);
+    }
+    buffer += ",\"order\":[";
+    append_list(buffer, record.order, ',');
+    buffer += "],\"completion\":[";
+    append_list(buffer, record.completion, ',');
+    buffer += "],\"lateness\":[";
+    append_list(buffer, record.lateness, ',');
+    buffer += "],\"tardiness\":[";
+    append_list(buffer, record.tardiness, ',');
+    buffer += "]}\n";
+}
+
+// Fields are quoted only when they contain a separator, quotes are doubled
+static void append_csv_field(std::string &buffer, const std::string &value) {
+    if (value.find_first_of(",\"\n") == std::string::npos) {
+        buffer += value;
+        return;
+    }
+    buffer += '"';
+    for (char ch: value) {
+        if (ch == '"') {
+            buffer += '"';
+        }
+        buffer += ch;
+    }
+    buffer += '"';
+}
+
+static void append_csv(std::string &buffer, const ResultRecord &record) {
+    const RunMetadata &meta = record.metadata;
+    append_csv_field(buffer, meta.objective);
+    buffer += ',';
+    append_csv_field(buffer, meta.instance);
+    const long long numbers[] = {meta.jobs_num, meta.machines_num, meta.iterations, meta.neighbors,
+                                 meta.cooling_strategy, meta.t0, meta.seed, meta.evaluations};
+    for (long long number: numbers) {
+        buffer += ',';
+        append_int(buffer, number);
+    }
+    buffer += ',';
+    append_fixed(buffer, meta.runtime_seconds, 6);
+    int fields[RECORD_CRITERIA];
+    criteria_fields(record, fields);
+    for (int field: fields) {
+        buffer += ',';
+        append_int(buffer, field);
+    }
+    const std::vector<int> *lists[] = {&record.order, &record.completion, &record.lateness, &record.tardiness};
+    for (const std::vector<int> *list: lists) {
+        buffer += ',';
+        append_list(buffer, *list, ' ');
+    }
+    buffer += '\n';
+}
+
+static void append_u16(std::string &buffer, uint16_t value) {
+    buffer += static_cast<char>(value & 0xFF);
+    buffer += static_cast<char>(value >> 8);
+}
+
+static void append_u32(std::string &buffer, uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        buffer += static_cast<char>((value >> shift) & 0xFF);
+    }
+}
+
+static void append_u64(std::string &buffer, uint64_t value) {
+    for (int shift = 0; shift < 64; shift += 8) {
+        buffer += static_cast<char>((value >> shift) & 0xFF);
+    }
+}
+
+static void append_name(std::string &buffer, const std::string &name) {
+    uint16_t length = name.size() > 0xFFFF ? 0xFFFF : static_cast<uint16_t>(name.size());
+    append_u16(buffer, length);
+    buffer.append(name, 0, length);
+}
+
+static void append_binary(std::string &buffer, const ResultRecord &record) {
+    const RunMetadata &meta = record.metadata;
+    buffer += "FSR2";
+    std::size_t length_at = buffer.size();
+    append_u32(buffer, 0);
+    const int32_t fields[] = {meta.jobs_num, meta.machines_num, meta.iterations, meta.neighbors,
+                              meta.cooling_strategy, meta.t0, static_cast<int32_t>(meta.seed)};
+    for (int32_t field: fields) {
+        append_u32(buffer, static_cast<uint32_t>(field));
+    }
+    int criteria[RECORD_CRITERIA];
+    criteria_fields(record, criteria);
+    for (int field: criteria) {
+        append_u32(buffer, static_cast<uint32_t>(field));
+    }
+    append_u64(buffer, static_cast<uint64_t>(meta.evaluations));
+    append_u64(buffer, static_cast<uint64_t>(meta.runtime_seconds * 1e6));
+    append_name(buffer, meta.objective);
+    append_name(buffer, meta.instance);
+    const std::vector<int> *lists[] = {&record.order, &record.completion, &record.lateness, &record.tardiness};
+    for (const std::vector<int> *list: lists) {
+        for (int value: *list) {
+            append_u32(buffer, static_cast<uint32_t>(value));
+        }
+    }
+    uint32_t length = buffer.size() - length_at - 4;
+    for (int k = 0; k < 4; ++k) {
+        buffer[length_at + k] = static_cast<char>((length >> (8 * k)) & 0xFF);
+    }
+}
+
+void append_result(std::string &buffer, ExportFormat format, const ResultRecord &record) {
+    if (format == ExportFormat::jsonl) {
+        append_jsonl(buffer, record);
+    } else if (format == ExportFormat::csv) {
+        append_csv(buffer, record);
+    } else {
+        append_binary(buffer, record);
+    }
+}
+
+ResultWriter::ResultWriter(std::FILE *file, ExportFormat format)
+        : file_(file), format_(format), header_written_(false) {
+    // a file opened for appending that already holds records already has its header;
+    // streams that cannot seek (pipes, the console) are treated as empty
+    if (format_ == ExportFormat::csv && std::fseek(file_, 0, SEEK_END) == 0) {
+        header_written_ = std::ftell(file_) > 0;
+    }
+}
+
+bool ResultWriter::write(const ResultRecord &record) {
+    buffer_.clear();
+    if (format_ == ExportFormat::csv && !header_written_) {
+        buffer_ += CSV_HEADER;
+        header_written_ = true;
+    }
+    append_result(buffer_, format_, record);
+    return std::fwrite(buffer_.data(), 1, buffer_.size(), file_) == buffer_.size();
+}
+
+bool parse_export_format(const std::string &name, ExportFormat &format) {
+    if (name == "jsonl") {
+        format = ExportFormat::jsonl;
+    } else if (name == "csv") {
+        format = ExportFormat::csv;
+    } else if (name == "binary") {
+        format = ExportFormat::binary;
+    } else {
+        return false;
+    }
+    return true;
+}
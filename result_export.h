@@ -0,0 +1,131 @@
+#ifndef RESULT_EXPORT_H
+#define RESULT_EXPORT_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "deadlines.h"
+#include "objectives.h"
+
+/**
+ * @brief Machine-readable result formats.
+ *
+ * - jsonl: One JSON object per line.
+ * - csv: One row per result, preceded by a header row; per-job values are
+ *   space-separated lists inside a field.
+ * - binary: Length-prefixed little-endian records, see append_result().
+ */
+enum class ExportFormat {
+    jsonl,
+    csv,
+    binary
+};
+
+/**
+ * @brief Struct representing the metadata of a solver run.
+ */
+struct RunMetadata {
+    std::string objective;
+    std::string instance;
+    int jobs_num;
+    int machines_num;
+    int iterations;
+    int neighbors;
+    int cooling_strategy;
+    int t0;
+    unsigned seed;
+    long long evaluations;
+    double runtime_seconds;
+};
+
+/**
+ * @brief Struct representing one solver result ready for export.
+ *
+ * value is the objective value of the run, criteria every criterion of its schedule.
+ * The per-job vectors are indexed by job (job 1 first).
+ */
+struct ResultRecord {
+    RunMetadata metadata;
+    std::vector<int> order;
+    int value;
+    CriteriaValues criteria;
+    std::vector<int> completion;
+    std::vector<int> lateness;
+    std::vector<int> tardiness;
+};
+
+/**
+ * @brief Assemble a result record from a job order and its deadline metrics.
+ *
+ * @param metadata The metadata of the run.
+ * @param order The job order found by the solver.
+ * @param value The objective value of the order.
+ * @param criteria The criteria of the order, see schedule_criteria().
+ * @param deadlines The deadline metrics of the order, see calculate_deadlines().
+ *
+ * @return ResultRecord The record.
+ */
+ResultRecord make_result_record(const RunMetadata &metadata,
+                                const std::vector<int> &order,
+                                int value,
+                                const CriteriaValues &criteria,
+                                const Deadlines &deadlines);
+
+/**
+ * @brief Append a result record to a buffer.
+ *
+ * The binary record is a "FSR2" magic, a uint32 length of the rest of the record,
+ * then int32 fields jobs_num, machines_num, iterations, neighbors, cooling_strategy,
+ * t0, seed, value, c_max, t_sum, flowtime, weighted_tardiness, max_lateness,
+ * tardy_jobs, int64 evaluations and runtime in microseconds, the
+ * objective and instance names as uint16 length + bytes, and finally the order,
+ * completion, lateness and tardiness arrays of jobs_num int32 each.
+ *
+ * @param buffer The buffer the record is appended to.
+ * @param format The output format.
+ * @param record The record.
+ */
+void append_result(std::string &buffer, ExportFormat format, const ResultRecord &record);
+
+/**
+ * @brief Writer of result records with one write call per record.
+ *
+ * The record is rendered into a reused buffer and handed to the file in a single
+ * fwrite, without flushing. The CSV header is written before the first record,
+ * unless the file already holds data (a file opened for appending to earlier results).
+ */
+class ResultWriter {
+public:
+    /**
+     * @brief Construct a writer.
+     *
+     * @param file The file to write to; it is not closed by the writer.
+     * @param format The output format.
+     */
+    ResultWriter(std::FILE *file, ExportFormat format);
+
+    /**
+     * @brief Write one record.
+     *
+     * @return bool True if the record was written completely.
+     */
+    bool write(const ResultRecord &record);
+
+private:
+    std::FILE *file_;
+    ExportFormat format_;
+    bool header_written_;
+    std::string buffer_;
+};
+
+/**
+ * @brief Parse the name of an export format.
+ *
+ * @param name "jsonl", "csv" or "binary".
+ * @param format Output for the parsed format.
+ *
+ * @return bool True if the name is known.
+ */
+bool parse_export_format(const std::string &name, ExportFormat &format);
+
+#endif // RESULT_EXPORT_H
@@ -0,0 +1,208 @@
+#include "sequence_evaluator.h"
+#include "no_wait.h"
+#include "setup_times.h"
+#include "machine_kernels.h"
+#include <algorithm>
+#include <climits>
+#include <thread>
+
+SequenceEvaluator::SequenceEvaluator(const std::vector<std::vector<int>> &jobs, int jobs_num, int machines_num,
+                                     const std::vector<int> &deadlines, Objective objective,
+                                     const ObjectiveContext *context)
+        : jobs_num_(jobs_num), machines_num_(machines_num), objective_(objective), width_(TimeWidth::w32),
+          deadlines_(jobs_num, 0), job_weights_(jobs_num, 1),
+          weights_(criteria_weights(objective, context != nullptr ? context->combination : CriteriaWeights())),
+          prefix_sum_(jobs_num + 1, 0), prefix_lateness_(jobs_num + 1, LLONG_MIN),
+          suffix_lateness_(jobs_num + 1, LLONG_MIN),
+          setups_(context != nullptr && objective != Objective::no_wait_c_max ? context->setups : nullptr),
+          base_c_max_(0), base_total_(0), base_value_(0), last_cost_(0) {
+    for (int j = 0; j < jobs_num; ++j) {
+        if (j < static_cast<int>(deadlines.size())) {
+            deadlines_[j] = deadlines[j];
+        }
+        if (context != nullptr && j < static_cast<int>(context->job_weights.size())) {
+            job_weights_[j] = context->job_weights[j];
+        }
+    }
+    if (link_based()) {
+        delays_ = context != nullptr && context->delays != nullptr
+                  ? context->delays
+                  : std::make_shared<DelayMatrix>(jobs, jobs_num, machines_num,
+                                                  std::max(1u, std::thread::hardware_concurrency()));
+        links_.assign(jobs_num, 0);
+        return;
+    }
+    width_ = choose_time_width(completion_time_bound(jobs, jobs_num, machines_num, setups_));
+    if (width_ == TimeWidth::w16) {
+        fill_buffers(narrow_, jobs);
+    } else if (width_ == TimeWidth::w32) {
+        fill_buffers(regular_, jobs);
+    } else {
+        fill_buffers(wide_, jobs);
+    }
+}
+
+template<typename T>
+void SequenceEvaluator::fill_buffers(TimeBuffers<T> &buffers, const std::vector<std::vector<int>> &jobs) {
+    const int m = machines_num_;
+    buffers.processing.resize(static_cast<std::size_t>(jobs_num_) * m);
+    buffers.prefix.assign(static_cast<std::size_t>(jobs_num_ + 1) * m, 0);
+    buffers.state.assign(m, 0);
+    for (int j = 0; j < jobs_num_; ++j) {
+        for (int i = 0; i < m; ++i) {
+            buffers.processing[j * m + i] = static_cast<T>(jobs[j][i]);
+        }
+    }
+}
+
+int SequenceEvaluator::link(const std::vector<int> &sequence, int p) const {
+    return p + 1 < jobs_num_ ? delays_->delay(sequence[p], sequence[p + 1]) : delays_->length(sequence[p]);
+}
+
+int SequenceEvaluator::combine(long long c_max, long long additive, long long max_lateness) const {
+    long long value = weights_.c_max * c_max + additive;
+    return checked_value(weights_.max_lateness != 0 ? value + weights_.max_lateness * max_lateness : value);
+}
+
+int SequenceEvaluator::rebase(const std::vector<int> &sequence) {
+    if (link_based()) {
+        base_total_ = 0;
+        for (int p = 0; p < jobs_num_; ++p) {
+            links_[p] = link(sequence, p);
+            base_total_ += links_[p];
+        }
+        last_cost_ = jobs_num_;
+        base_value_ = checked_value(base_total_);
+        return base_value_;
+    }
+    if (width_ == TimeWidth::w16) {
+        return rebase_width(narrow_, sequence);
+    } else if (width_ == TimeWidth::w32) {
+        return rebase_width(regular_, sequence);
+    }
+    return rebase_width(wide_, sequence);
+}
+
+template<typename T>
+int SequenceEvaluator::rebase_width(TimeBuffers<T> &buffers, const std::vector<int> &sequence) {
+    switch (machines_num_) {
+        case 5:
+            return rebase_times<T, 5>(buffers, sequence);
+        case 10:
+            return rebase_times<T, 10>(buffers, sequence);
+        case 20:
+            return rebase_times<T, 20>(buffers, sequence);
+        default:
+            return rebase_times<T, 0>(buffers, sequence);
+    }
+}
+
+template<typename T, int M>
+int SequenceEvaluator::rebase_times(TimeBuffers<T> &buffers, const std::vector<int> &sequence) {
+    const int m = M > 0 ? M : machines_num_;
+    for (int p = 0; p < jobs_num_; ++p) {
+        const T *proc = &buffers.processing[(sequence[p] - 1) * m];
+        const T *prev = &buffers.prefix[p * m];
+        T *row = &buffers.prefix[(p + 1) * m];
+        std::copy(prev, prev + m, row);
+        const int *setup = setups_ != nullptr && p > 0 ? setups_->row(sequence[p - 1], sequence[p]) : nullptr;
+        long long c = M > 0 ? append_job_fixed<M>(proc, setup, row) : append_job(proc, setup, m, row);
+        int job = sequence[p] - 1;
+        prefix_sum_[p + 1] = prefix_sum_[p] + additive_criteria(weights_, c, deadlines_[job], job_weights_[job]);
+        prefix_lateness_[p + 1] = std::max(prefix_lateness_[p], c - deadlines_[job]);
+        suffix_lateness_[p] = c - deadlines_[job];
+    }
+    for (int p = jobs_num_ - 1; p >= 0; --p) {
+        suffix_lateness_[p] = std::max(suffix_lateness_[p], suffix_lateness_[p + 1]);
+    }
+    base_c_max_ = buffers.prefix[jobs_num_ * m + m - 1];
+    base_value_ = combine(base_c_max_, prefix_sum_[jobs_num_], prefix_lateness_[jobs_num_]);
+    last_cost_ = static_cast<long long>(jobs_num_) * m;
+    return base_value_;
+}
+
+int SequenceEvaluator::evaluate(const std::vector<int> &sequence, int first, int last) {
+    if (link_based()) {
+        // the links touching the window, from the one entering it to the one leaving it
+        long long value = base_total_;
+        int from = std::max(0, first - 1);
+        int to = std::min(jobs_num_ - 1, last);
+        for (int p = from; p <= to; ++p) {
+            value += link(sequence, p) - links_[p];
+        }
+        last_cost_ = to - from + 1;
+        return checked_value(value);
+    }
+    if (width_ == TimeWidth::w16) {
+        return evaluate_width(narrow_, sequence, first, last);
+    } else if (width_ == TimeWidth::w32) {
+        return evaluate_width(regular_, sequence, first, last);
+    }
+    return evaluate_width(wide_, sequence, first, last);
+}
+
+template<typename T>
+int SequenceEvaluator::evaluate_width(TimeBuffers<T> &buffers, const std::vector<int> &sequence, int first,
+                                      int last) {
+    switch (machines_num_) {
+        case 5:
+            return evaluate_times<T, 5>(buffers, sequence, first, last);
+        case 10:
+            return evaluate_times<T, 10>(buffers, sequence, first, last);
+        case 20:
+            return evaluate_times<T, 20>(buffers, sequence, first, last);
+        default:
+            return evaluate_times<T, 0>(buffers, sequence, first, last);
+    }
+}
+
+template<typename T, int M>
+int SequenceEvaluator::evaluate_times(TimeBuffers<T> &buffers, const std::vector<int> &sequence, int first,
+                                      int last) {
+    const int m = M > 0 ? M : machines_num_;
+    // a specialized kernel keeps the machine completion times in a fixed-size local array (registers)
+    T local[M > 0 ? M : 1];
+    T *state = M > 0 ? local : buffers.state.data();
+    std::copy(&buffers.prefix[first * m], &buffers.prefix[(first + 1) * m], state);
+    long long additive = prefix_sum_[first];
+    long long max_lateness = prefix_lateness_[first];
+    int p = first;
+    // with setups the job in front of p must lie behind the window as well
+    int settled = setups_ != nullptr ? last + 1 : last;
+    for (; p < jobs_num_; ++p) {
+        // behind the window, identical completion times mean an identical rest of the schedule
+        if (p > settled && std::equal(state, state + m, &buffers.prefix[p * m])) {
+            break;
+        }
+        const T *proc = &buffers.processing[(sequence[p] - 1) * m];
+        const int *setup = setups_ != nullptr && p > 0 ? setups_->row(sequence[p - 1], sequence[p]) : nullptr;
+        long long c = M > 0 ? append_job_fixed<M>(proc, setup, state) : append_job(proc, setup, m, state);
+        int job = sequence[p] - 1;
+        additive += additive_criteria(weights_, c, deadlines_[job], job_weights_[job]);
+        max_lateness = std::max(max_lateness, c - deadlines_[job]);
+    }
+    last_cost_ = static_cast<long long>(p - first) * m;
+    if (p < jobs_num_) {
+        // the rest of the schedule is the one of the base order
+        return combine(base_c_max_, additive + prefix_sum_[jobs_num_] - prefix_sum_[p],
+                       std::max(max_lateness, suffix_lateness_[p]));
+    }
+    return combine(state[m - 1], additive, max_lateness);
+}
+
+int SequenceEvaluator::evaluate_links(const std::vector<int> &sequence, const int *removed, int removed_count,
+                                      const int *added, int added_count) {
+    long long value = base_total_;
+    for (int k = 0; k < removed_count; ++k) {
+        if (removed[k] >= 0 && removed[k] < jobs_num_) {
+            value -= links_[removed[k]];
+        }
+    }
+    for (int k = 0; k < added_count; ++k) {
+        if (added[k] >= 0 && added[k] < jobs_num_) {
+            value += link(sequence, added[k]);
+        }
+    }
+    last_cost_ = added_count;
+    return checked_value(value);
+}
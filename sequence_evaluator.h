@@ -0,0 +1,170 @@
+#ifndef SEQUENCE_EVALUATOR_H
+#define SEQUENCE_EVALUATOR_H
+
+#include <memory>
+#include <vector>
+#include "objectives.h"
+#include "time_width.h"
+
+class DelayMatrix;
+
+/**
+ * @brief Incremental evaluator of job orders that differ locally from a base order.
+ *
+ * The evaluator keeps the machine completion times after every prefix of a base
+ * order (and the criteria accumulated by every prefix). A neighbor that differs
+ * from the base only inside the window [first, last] is then evaluated by
+ * restarting the recurrence at the first changed position. Behind the window the
+ * recurrence stops as soon as its machine completion times match those of the
+ * base again, since from there on the two schedules are identical.
+ *
+ * The no-wait makespan is a sum over the links between consecutive jobs (and the
+ * length of the last job), so for it the evaluator keeps the links of the base
+ * order instead and a neighbor costs one delay lookup per changed link.
+ *
+ * With sequence-dependent setup times the job in front of a position matters as
+ * well, so behind the window the recurrence stops one position later.
+ *
+ * The other objectives are evaluated as a weighted sum (see CriteriaWeights): the
+ * criteria that add up a term per job keep one prefix sum, the maximum lateness
+ * keeps a prefix and a suffix maximum, so a stopped recurrence still knows the
+ * value of the whole order.
+ *
+ * The completion times are kept in the narrowest integer type that holds every
+ * completion time of the instance (see TimeWidth), picked when the evaluator is
+ * built; the recurrence is a template dispatched on it once per evaluation. The
+ * criteria are accumulated in 64 bits, and a value that does not fit into an int
+ * throws std::overflow_error instead of wrapping around. For the common machine
+ * counts the recurrence is also instantiated with a constant machine count, see
+ * machine_kernels.h.
+ */
+class SequenceEvaluator {
+public:
+    /**
+     * @brief Construct an evaluator for one instance and objective.
+     *
+     * @param jobs A 2D vector representing the processing times of jobs on each machine.
+     * @param jobs_num The total number of jobs.
+     * @param machines_num The total number of machines.
+     * @param deadlines A vector representing the deadlines for each job.
+     * @param objective The objective to evaluate.
+     * @param context Optional setups, job weights and combination, may be nullptr. The
+     * no-wait objective ignores the setups. The context is copied, except for the
+     * setups, which must outlive the evaluator, and the delay matrix, which is shared.
+     */
+    SequenceEvaluator(const std::vector<std::vector<int>> &jobs,
+                      int jobs_num,
+                      int machines_num,
+                      const std::vector<int> &deadlines,
+                      Objective objective,
+                      const ObjectiveContext *context = nullptr);
+
+    /**
+     * @brief Evaluate a job order in full and make it the new base order.
+     *
+     * @param sequence The job order (1-based job numbers).
+     *
+     * @return int The objective value of the order.
+     */
+    int rebase(const std::vector<int> &sequence);
+
+    /**
+     * @brief Evaluate a job order that differs from the base only inside a window.
+     *
+     * @param sequence The job order (1-based job numbers).
+     * @param first The first position that differs from the base order.
+     * @param last The last position that differs from the base order.
+     *
+     * @return int The objective value of the order.
+     */
+    int evaluate(const std::vector<int> &sequence, int first, int last);
+
+    /**
+     * @brief Evaluate an order from the links that differ from the base order.
+     *
+     * Link p joins the jobs at positions p and p + 1; link n - 1 is the length of the
+     * last job. Only valid for a link-based objective, see link_based(). Positions
+     * outside [0, n - 1] are ignored; a position must not be listed twice.
+     *
+     * @param sequence The job order (1-based job numbers).
+     * @param removed The links of the base order the order no longer has.
+     * @param removed_count The number of removed links.
+     * @param added The links of the order that replace them.
+     * @param added_count The number of added links.
+     *
+     * @return int The objective value of the order.
+     */
+    int evaluate_links(const std::vector<int> &sequence, const int *removed, int removed_count, const int *added,
+                       int added_count);
+
+    /**
+     * @brief Check if the objective is a sum over the links of consecutive jobs.
+     */
+    bool link_based() const { return objective_ == Objective::no_wait_c_max; }
+
+    /**
+     * @brief Get the objective value of the base order.
+     */
+    int base_value() const { return base_value_; }
+
+    /**
+     * @brief Get the number of (position, machine) cells the last evaluation computed.
+     */
+    long long last_cost() const { return last_cost_; }
+
+    /**
+     * @brief Get the width the completion times are computed in.
+     */
+    TimeWidth time_width() const { return width_; }
+
+    Objective objective() const { return objective_; }
+    int jobs_num() const { return jobs_num_; }
+    int machines_num() const { return machines_num_; }
+
+private:
+    // The completion times of one width; only the buffers of the chosen width are filled
+    template<typename T>
+    struct TimeBuffers {
+        std::vector<T> processing;  // job-major, processing[job * m + machine]
+        std::vector<T> prefix;      // completion times after p positions, prefix[p * m + machine]
+        std::vector<T> state;
+    };
+
+    template<typename T>
+    void fill_buffers(TimeBuffers<T> &buffers, const std::vector<std::vector<int>> &jobs);
+    // M is the machine count of a specialized kernel, 0 for the generic loop
+    template<typename T>
+    int rebase_width(TimeBuffers<T> &buffers, const std::vector<int> &sequence);
+    template<typename T>
+    int evaluate_width(TimeBuffers<T> &buffers, const std::vector<int> &sequence, int first, int last);
+    template<typename T, int M>
+    int rebase_times(TimeBuffers<T> &buffers, const std::vector<int> &sequence);
+    template<typename T, int M>
+    int evaluate_times(TimeBuffers<T> &buffers, const std::vector<int> &sequence, int first, int last);
+
+    int link(const std::vector<int> &sequence, int p) const;
+    int combine(long long c_max, long long additive, long long max_lateness) const;
+
+    int jobs_num_;
+    int machines_num_;
+    Objective objective_;
+    TimeWidth width_;
+    TimeBuffers<uint16_t> narrow_;
+    TimeBuffers<int32_t> regular_;
+    TimeBuffers<int64_t> wide_;
+    std::vector<int> deadlines_;
+    std::vector<int> job_weights_;
+    CriteriaWeights weights_;
+    std::vector<long long> prefix_sum_;      // weighted additive criteria of the first p positions
+    std::vector<long long> prefix_lateness_; // maximum lateness of the first p positions
+    std::vector<long long> suffix_lateness_; // maximum lateness of the positions from p on
+    const SetupTimes *setups_;
+    std::shared_ptr<const DelayMatrix> delays_;  // no-wait only
+    std::vector<int> links_;                     // links of the base order, no-wait only
+    long long base_c_max_;
+    long long base_total_;                       // sum of the links, no-wait only
+    int base_value_;
+    long long last_cost_;
+};
+
+#endif // SEQUENCE_EVALUATOR_H
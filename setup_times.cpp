@@ -0,0 +1,163 @@
+#include "setup_times.h"
+#include <algorithm>
+#include <map>
+#include "simd_kernels.h"
+
+// Groups the jobs whose setups to and from every other job are equal, false if that saves nothing
+static bool find_families(int n, int m, const std::vector<int> &tensor, std::vector<int> &family) {
+    auto pair = [&](int k, int j) { return tensor.begin() + (static_cast<std::size_t>(k) * n + j) * m; };
+    std::vector<int> representatives;
+    family.assign(n, -1);
+    for (int j = 0; j < n; ++j) {
+        for (std::size_t f = 0; f < representatives.size() && family[j] < 0; ++f) {
+            int r = representatives[f];
+            bool same = true;
+            for (int x = 0; x < n && same; ++x) {
+                if (x != j && x != r) {
+                    same = std::equal(pair(j, x), pair(j, x) + m, pair(r, x)) &&
+                           std::equal(pair(x, j), pair(x, j) + m, pair(x, r));
+                }
+            }
+            if (same) {
+                family[j] = f;
+            }
+        }
+        if (family[j] < 0) {
+            family[j] = representatives.size();
+            representatives.push_back(j);
+            if (static_cast<int>(representatives.size()) > n / 2) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+SetupTimes::SetupTimes(int jobs_num, int machines_num, const std::vector<int> &tensor, bool compress)
+        : jobs_num_(jobs_num), machines_num_(machines_num), storage_(SetupStorage::dense), values_(tensor),
+          families_(0), bound_(0) {
+    const int n = jobs_num, m = machines_num;
+    for (int j = 0; j < n; ++j) {
+        long long largest = 0;
+        for (int k = 0; k < n; ++k) {
+            if (k != j) {
+                const int *setup = &tensor[(static_cast<std::size_t>(k) * n + j) * m];
+                long long total = 0;
+                for (int i = 0; i < m; ++i) {
+                    total += setup[i];
+                }
+                largest = std::max(largest, total);
+            }
+        }
+        bound_ += largest;
+    }
+    if (!compress || n < 2) {
+        return;
+    }
+    auto pair = [&](int k, int j) { return tensor.begin() + (static_cast<std::size_t>(k) * n + j) * m; };
+    std::size_t dense_size = tensor.size();
+
+    std::vector<int> family;
+    if (find_families(n, m, tensor, family)) {
+        int families = *std::max_element(family.begin(), family.end()) + 1;
+        std::vector<int> table(static_cast<std::size_t>(families) * families * m, 0);
+        std::vector<char> filled(static_cast<std::size_t>(families) * families, 0);
+        bool exact = true;
+        for (int k = 0; k < n && exact; ++k) {
+            for (int j = 0; j < n && exact; ++j) {
+                if (k == j) {
+                    continue;
+                }
+                std::size_t cell = static_cast<std::size_t>(family[k]) * families + family[j];
+                if (!filled[cell]) {
+                    std::copy(pair(k, j), pair(k, j) + m, table.begin() + cell * m);
+                    filled[cell] = 1;
+                }
+                // the jobs of a family must also agree on the setups among themselves
+                exact = std::equal(pair(k, j), pair(k, j) + m, table.begin() + cell * m);
+            }
+        }
+        if (exact && table.size() + family.size() < dense_size) {
+            storage_ = SetupStorage::family;
+            values_.swap(table);
+            family_.swap(family);
+            families_ = families;
+            dense_size = values_.size() + family_.size();
+        }
+    }
+
+    // the most common setup of every machine is the default, the deviating pairs are listed
+    std::vector<int> defaults(m);
+    for (int i = 0; i < m; ++i) {
+        std::map<int, int> counts;
+        for (int k = 0; k < n; ++k) {
+            for (int j = 0; j < n; ++j) {
+                if (k != j) {
+                    ++counts[pair(k, j)[i]];
+                }
+            }
+        }
+        defaults[i] = std::max_element(counts.begin(), counts.end(), [](const std::pair<const int, int> &a,
+                                                                        const std::pair<const int, int> &b) {
+            return a.second < b.second;
+        })->first;
+    }
+    std::vector<int> starts(n + 1, 0), next, values;
+    for (int k = 0; k < n; ++k) {
+        for (int j = 0; j < n; ++j) {
+            if (k != j && !std::equal(pair(k, j), pair(k, j) + m, defaults.begin())) {
+                next.push_back(j + 1);
+                values.insert(values.end(), pair(k, j), pair(k, j) + m);
+            }
+        }
+        starts[k + 1] = next.size();
+        if (m + starts.size() + next.size() + values.size() >= dense_size) {
+            return;  // the current storage is at least as small
+        }
+    }
+    storage_ = SetupStorage::sparse;
+    values_.swap(values);
+    defaults_.swap(defaults);
+    starts_.swap(starts);
+    next_.swap(next);
+    family_.clear();
+    families_ = 0;
+}
+
+const int *SetupTimes::sparse_row(int previous, int next) const {
+    std::vector<int>::const_iterator first = next_.begin() + starts_[previous - 1];
+    std::vector<int>::const_iterator last = next_.begin() + starts_[previous];
+    std::vector<int>::const_iterator found = std::lower_bound(first, last, next);
+    if (found != last && *found == next) {
+        return &values_[(found - next_.begin()) * machines_num_];
+    }
+    return defaults_.data();
+}
+
+std::size_t SetupTimes::memory() const {
+    return sizeof(int) * (values_.size() + family_.size() + defaults_.size() + starts_.size() + next_.size());
+}
+
+int append_with_setup(const int *processing, const int *setup, int machines_num, int *state) {
+    if (setup != nullptr) {
+        simd_kernels().add_setups(state, setup, machines_num);
+    }
+    int c = 0;
+    for (int i = 0; i < machines_num; ++i) {
+        c = std::max(c, state[i]) + processing[i];
+        state[i] = c;
+    }
+    return c;
+}
+
+std::string setup_storage_name(SetupStorage storage) {
+    std::string name;
+    if (storage == SetupStorage::dense) {
+        name = "dense";
+    } else if (storage == SetupStorage::family) {
+        name = "family";
+    } else if (storage == SetupStorage::sparse) {
+        name = "sparse";
+    }
+    return name;
+}
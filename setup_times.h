@@ -0,0 +1,113 @@
+#ifndef SETUP_TIMES_H
+#define SETUP_TIMES_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief How a SetupTimes object stores its tensor.
+ *
+ * - dense: Every (previous, next) pair has its own row of m setup times.
+ * - family: Jobs fall into families and the setup only depends on the families of the
+ *   two jobs, so an F x F table of rows replaces the n x n one (a low-rank tensor).
+ * - sparse: One default row and a sorted list of the pairs that deviate from it.
+ */
+enum class SetupStorage {
+    dense,
+    family,
+    sparse
+};
+
+/**
+ * @brief Sequence-dependent setup times of a flow shop.
+ *
+ * The setup of machine i between job k and a directly following job j is an entry
+ * of an m x n x n tensor. It is stored with the machine as the fastest index, so
+ * the m setups of a pair form one contiguous row that the recurrence reads next to
+ * the processing times of the job. Every storage returns such a row, see row().
+ * The first job of an order has no setup.
+ */
+class SetupTimes {
+public:
+    /**
+     * @brief Construct the setup times from a dense tensor.
+     *
+     * @param jobs_num The total number of jobs.
+     * @param machines_num The total number of machines.
+     * @param tensor The setups, tensor[(previous * jobs_num + next) * machines_num + machine]
+     * for 0-based jobs; the diagonal is never read.
+     * @param compress If true, the smallest storage that represents the tensor exactly
+     * is picked (see SetupStorage), otherwise it is kept dense.
+     */
+    SetupTimes(int jobs_num, int machines_num, const std::vector<int> &tensor, bool compress = true);
+
+    /**
+     * @brief Get the m setups between two consecutive jobs (1-based).
+     */
+    const int *row(int previous, int next) const {
+        if (storage_ == SetupStorage::dense) {
+            return &values_[(static_cast<std::size_t>(previous - 1) * jobs_num_ + next - 1) * machines_num_];
+        } else if (storage_ == SetupStorage::family) {
+            return &values_[(family_[previous - 1] * families_ + family_[next - 1]) * machines_num_];
+        }
+        return sparse_row(previous, next);
+    }
+
+    SetupStorage storage() const { return storage_; }
+
+    /**
+     * @brief Get the number of bytes the stored tensor takes.
+     */
+    std::size_t memory() const;
+
+    /**
+     * @brief Get the sum over all jobs of the largest total setup in front of the job.
+     *
+     * No order spends more time on setups, see completion_time_bound().
+     */
+    long long bound() const { return bound_; }
+
+    int jobs_num() const { return jobs_num_; }
+    int machines_num() const { return machines_num_; }
+
+private:
+    const int *sparse_row(int previous, int next) const;
+
+    int jobs_num_;
+    int machines_num_;
+    SetupStorage storage_;
+    std::vector<int> values_;    // dense rows, family rows, or the deviating sparse rows
+    std::vector<int> family_;    // family of every job, family storage only
+    int families_;
+    std::vector<int> defaults_;  // the default row, sparse storage only
+    std::vector<int> starts_;    // first entry of every previous job, sparse storage only
+    std::vector<int> next_;      // next job of every entry, sorted per previous job
+    long long bound_;
+};
+
+/**
+ * @brief Append a job to a partial schedule whose machines first run a setup.
+ *
+ * state holds the completion times of the partial schedule on every machine and is
+ * replaced by those after the job. Machine i starts the setup as soon as it is
+ * free and the job as soon as the setup and the job's previous operation are done:
+ * C(i) = max(C(i - 1), state(i) + setup(i)) + processing(i). The additions of the
+ * setups do not depend on each other and run in the SIMD kernels of the selected
+ * instruction set (see simd_kernels.h), only the maximum chain along the machines is scalar.
+ *
+ * @param processing The m processing times of the job.
+ * @param setup The m setup times before the job, nullptr for none.
+ * @param machines_num The total number of machines.
+ * @param state The completion times on every machine, updated in place.
+ *
+ * @return int The completion time of the job on the last machine.
+ */
+int append_with_setup(const int *processing, const int *setup, int machines_num, int *state);
+
+/**
+ * @brief Get the name of a setup storage.
+ */
+std::string setup_storage_name(SetupStorage storage);
+
+#endif // SETUP_TIMES_H
@@ -0,0 +1,262 @@
+#include "simd_kernels.h"
+#include <algorithm>
+#include <atomic>
+
+// The vector variants need per-function target attributes and CPUID, both GCC and Clang on x86
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86
+#include <immintrin.h>
+#endif
+
+static void add_setups_generic(int *state, const int *setup, int count) {
+    for (int i = 0; i < count; ++i) {
+        state[i] += setup[i];
+    }
+}
+
+// One machine of the insertion evaluation for the positions [from, to)
+static void insertion_step(int p, const int *e, const int *q, int from, int to, int *front, int *makespan) {
+    for (int pos = from; pos < to; ++pos) {
+        int f = std::max(front[pos], pos > 0 ? e[pos - 1] : 0) + p;
+        front[pos] = f;
+        makespan[pos] = std::max(makespan[pos], f + q[pos]);
+    }
+}
+
+static void insertion_makespans_generic(const int *processing, int machines_num, int stride, int from, int to,
+                                        const int *head, const int *tail, int *front, int *makespan) {
+    std::fill(front + from, front + to, 0);
+    std::fill(makespan + from, makespan + to, 0);
+    for (int i = 0; i < machines_num; ++i) {
+        insertion_step(processing[i], head + i * stride, tail + i * stride, from, to, front, makespan);
+    }
+}
+
+static long long tardiness_sum_generic(const int *completion, const int *deadlines, int count) {
+    long long sum = 0;
+    for (int j = 0; j < count; ++j) {
+        sum += std::max(0, completion[j] - deadlines[j]);
+    }
+    return sum;
+}
+
+#ifdef SIMD_X86
+
+// Every position but the first reads the head of the position in front of it, so the vectors start at 1
+#define INSERTION_MAKESPANS(LANES, VEC, LOAD, STORE, SET1, ADD, MAX)                                    \
+    std::fill(front + from, front + to, 0);                                                            \
+    std::fill(makespan + from, makespan + to, 0);                                                      \
+    int first = std::max(from, 1);                                                                     \
+    for (int i = 0; i < machines_num; ++i) {                                                           \
+        const int *e = head + i * stride;                                                              \
+        const int *q = tail + i * stride;                                                              \
+        insertion_step(processing[i], e, q, from, std::min(first, to), front, makespan);               \
+        VEC p = SET1(processing[i]);                                                                   \
+        int pos = first;                                                                               \
+        for (; pos + LANES <= to; pos += LANES) {                                                      \
+            VEC f = ADD(MAX(LOAD(front + pos), LOAD(e + pos - 1)), p);                                 \
+            STORE(front + pos, f);                                                                     \
+            STORE(makespan + pos, MAX(LOAD(makespan + pos), ADD(f, LOAD(q + pos))));                   \
+        }                                                                                              \
+        insertion_step(processing[i], e, q, std::max(pos, first), to, front, makespan);                \
+    }
+
+#define SSE_LOAD(p) _mm_loadu_si128(reinterpret_cast<const __m128i *>(p))
+#define SSE_STORE(p, v) _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v)
+#define AVX2_LOAD(p) _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p))
+#define AVX2_STORE(p, v) _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v)
+
+__attribute__((target("sse4.2")))
+static void add_setups_sse42(int *state, const int *setup, int count) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        SSE_STORE(state + i, _mm_add_epi32(SSE_LOAD(state + i), SSE_LOAD(setup + i)));
+    }
+    add_setups_generic(state + i, setup + i, count - i);
+}
+
+__attribute__((target("sse4.2")))
+static void insertion_makespans_sse42(const int *processing, int machines_num, int stride, int from, int to,
+                                      const int *head, const int *tail, int *front, int *makespan) {
+    INSERTION_MAKESPANS(4, __m128i, SSE_LOAD, SSE_STORE, _mm_set1_epi32, _mm_add_epi32, _mm_max_epi32)
+}
+
+__attribute__((target("sse4.2")))
+static long long tardiness_sum_sse42(const int *completion, const int *deadlines, int count) {
+    // the tardiness of a job fits into 32 bits, the sum is kept in 64-bit lanes
+    __m128i sum = _mm_setzero_si128();
+    int j = 0;
+    for (; j + 4 <= count; j += 4) {
+        __m128i late = _mm_sub_epi32(SSE_LOAD(completion + j), SSE_LOAD(deadlines + j));
+        late = _mm_max_epi32(late, _mm_setzero_si128());
+        sum = _mm_add_epi64(sum, _mm_cvtepi32_epi64(late));
+        sum = _mm_add_epi64(sum, _mm_cvtepi32_epi64(_mm_srli_si128(late, 8)));
+    }
+    long long lanes[2];
+    SSE_STORE(lanes, sum);
+    return lanes[0] + lanes[1] + tardiness_sum_generic(completion + j, deadlines + j, count - j);
+}
+
+__attribute__((target("avx2")))
+static void add_setups_avx2(int *state, const int *setup, int count) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        AVX2_STORE(state + i, _mm256_add_epi32(AVX2_LOAD(state + i), AVX2_LOAD(setup + i)));
+    }
+    add_setups_generic(state + i, setup + i, count - i);
+}
+
+__attribute__((target("avx2")))
+static void insertion_makespans_avx2(const int *processing, int machines_num, int stride, int from, int to,
+                                     const int *head, const int *tail, int *front, int *makespan) {
+    INSERTION_MAKESPANS(8, __m256i, AVX2_LOAD, AVX2_STORE, _mm256_set1_epi32, _mm256_add_epi32, _mm256_max_epi32)
+}
+
+__attribute__((target("avx2")))
+static long long tardiness_sum_avx2(const int *completion, const int *deadlines, int count) {
+    __m256i sum = _mm256_setzero_si256();
+    int j = 0;
+    for (; j + 8 <= count; j += 8) {
+        __m256i late = _mm256_sub_epi32(AVX2_LOAD(completion + j), AVX2_LOAD(deadlines + j));
+        late = _mm256_max_epi32(late, _mm256_setzero_si256());
+        sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(late)));
+        sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(late, 1)));
+    }
+    long long lanes[4];
+    AVX2_STORE(lanes, sum);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+           tardiness_sum_generic(completion + j, deadlines + j, count - j);
+}
+
+// GCC 12's avx512fintrin.h builds _mm512_set1_epi32 and _mm512_reduce_add_epi64 from an
+// undefined vector, which -Wall reports as used uninitialized (GCC bug 105593)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#ifndef __clang__
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+__attribute__((target("avx512f")))
+static void add_setups_avx512(int *state, const int *setup, int count) {
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        _mm512_storeu_si512(state + i, _mm512_add_epi32(_mm512_loadu_si512(state + i), _mm512_loadu_si512(setup + i)));
+    }
+    add_setups_generic(state + i, setup + i, count - i);
+}
+
+__attribute__((target("avx512f")))
+static void insertion_makespans_avx512(const int *processing, int machines_num, int stride, int from, int to,
+                                       const int *head, const int *tail, int *front, int *makespan) {
+    INSERTION_MAKESPANS(16, __m512i, _mm512_loadu_si512, _mm512_storeu_si512, _mm512_set1_epi32, _mm512_add_epi32,
+                        _mm512_max_epi32)
+}
+
+__attribute__((target("avx512f")))
+static long long tardiness_sum_avx512(const int *completion, const int *deadlines, int count) {
+    __m512i sum = _mm512_setzero_si512();
+    int j = 0;
+    for (; j + 16 <= count; j += 16) {
+        __m512i late = _mm512_sub_epi32(_mm512_loadu_si512(completion + j), _mm512_loadu_si512(deadlines + j));
+        late = _mm512_max_epi32(late, _mm512_setzero_si512());
+        sum = _mm512_add_epi64(sum, _mm512_cvtepi32_epi64(_mm512_castsi512_si256(late)));
+        sum = _mm512_add_epi64(sum, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(late, 1)));
+    }
+    return _mm512_reduce_add_epi64(sum) + tardiness_sum_generic(completion + j, deadlines + j, count - j);
+}
+
+#pragma GCC diagnostic pop
+
+#endif
+
+// Indexed by Isa, the variants that are not compiled in fall back to the generic kernels
+static const SimdKernels KERNELS[] = {
+        {add_setups_generic, insertion_makespans_generic, tardiness_sum_generic},
+#ifdef SIMD_X86
+        {add_setups_sse42, insertion_makespans_sse42, tardiness_sum_sse42},
+        {add_setups_avx2, insertion_makespans_avx2, tardiness_sum_avx2},
+        {add_setups_avx512, insertion_makespans_avx512, tardiness_sum_avx512},
+#else
+        {add_setups_generic, insertion_makespans_generic, tardiness_sum_generic},
+        {add_setups_generic, insertion_makespans_generic, tardiness_sum_generic},
+        {add_setups_generic, insertion_makespans_generic, tardiness_sum_generic},
+#endif
+};
+
+// The selected instruction set, detected on first use
+static std::atomic<int> &active_slot() {
+    static std::atomic<int> slot(static_cast<int>(detect_isa()));
+    return slot;
+}
+
+const SimdKernels &simd_kernels() {
+    return KERNELS[active_slot().load(std::memory_order_relaxed)];
+}
+
+bool isa_supported(Isa isa) {
+    if (isa == Isa::generic) {
+        return true;
+    }
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+    if (isa == Isa::sse42) {
+        return __builtin_cpu_supports("sse4.2");
+    } else if (isa == Isa::avx2) {
+        return __builtin_cpu_supports("avx2");
+    } else if (isa == Isa::avx512) {
+        return __builtin_cpu_supports("avx512f");
+    }
+#endif
+    return false;
+}
+
+Isa detect_isa() {
+    const Isa candidates[] = {Isa::avx512, Isa::avx2, Isa::sse42};
+    for (Isa isa: candidates) {
+        if (isa_supported(isa)) {
+            return isa;
+        }
+    }
+    return Isa::generic;
+}
+
+bool select_isa(Isa isa) {
+    if (!isa_supported(isa)) {
+        return false;
+    }
+    active_slot().store(static_cast<int>(isa), std::memory_order_relaxed);
+    return true;
+}
+
+Isa active_isa() {
+    return static_cast<Isa>(active_slot().load(std::memory_order_relaxed));
+}
+
+bool parse_isa(const std::string &name, Isa &isa) {
+    if (name == "generic") {
+        isa = Isa::generic;
+    } else if (name == "sse4.2") {
+        isa = Isa::sse42;
+    } else if (name == "avx2") {
+        isa = Isa::avx2;
+    } else if (name == "avx512") {
+        isa = Isa::avx512;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string isa_name(Isa isa) {
+    std::string name;
+    if (isa == Isa::generic) {
+        name = "generic";
+    } else if (isa == Isa::sse42) {
+        name = "SSE4.2";
+    } else if (isa == Isa::avx2) {
+        name = "AVX2";
+    } else if (isa == Isa::avx512) {
+        name = "AVX-512";
+    }
+    return name;
+}
@@ -0,0 +1,90 @@
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <string>
+
+/**
+ * @brief Instruction sets the SIMD kernels are built for.
+ *
+ * Every variant is compiled into the same binary; the best one the CPU supports is
+ * selected at startup and can be overridden with select_isa().
+ *
+ * Only the kernels of SimdKernels dispatch on it: the setup additions, Taillard's
+ * insertion evaluation and the tardiness sums. The completion-time recurrence of
+ * append_job() and SequenceEvaluator stays scalar, every machine waits for the one
+ * in front of it; for small machine counts it is unrolled instead, see machine_kernels.h.
+ *
+ * - generic: Plain C++, runs everywhere.
+ * - sse42: 128-bit vectors, 4 lanes of 32 bits.
+ * - avx2: 256-bit vectors, 8 lanes.
+ * - avx512: 512-bit vectors, 16 lanes.
+ */
+enum class Isa {
+    generic,
+    sse42,
+    avx2,
+    avx512
+};
+
+/**
+ * @brief Struct holding the kernels of one instruction set.
+ *
+ * - add_setups: Adds count setup times to the machine completion times in state.
+ * - insertion_makespans: Taillard's evaluation of the insertion positions [from, to):
+ *   with head (e) and tail (q) stored machine-major with the given stride, writes the
+ *   makespan of inserting a job with the given processing times before every position.
+ *   front holds the completion times of the inserted job (f), one per position.
+ * - tardiness_sum: The sum of max(0, completion - deadline) over count jobs, in 64 bits;
+ *   the tardiness of every single job has to fit into an int.
+ */
+struct SimdKernels {
+    void (*add_setups)(int *state, const int *setup, int count);
+    void (*insertion_makespans)(const int *processing, int machines_num, int stride, int from, int to,
+                                const int *head, const int *tail, int *front, int *makespan);
+    long long (*tardiness_sum)(const int *completion, const int *deadlines, int count);
+};
+
+/**
+ * @brief Get the kernels of the selected instruction set.
+ */
+const SimdKernels &simd_kernels();
+
+/**
+ * @brief Get the best instruction set that is compiled in and supported by the CPU.
+ */
+Isa detect_isa();
+
+/**
+ * @brief Check if an instruction set is compiled in and supported by the CPU.
+ */
+bool isa_supported(Isa isa);
+
+/**
+ * @brief Force the kernels of an instruction set, e.g. to compare the variants.
+ *
+ * Must be called before any worker thread starts.
+ *
+ * @param isa The instruction set to use.
+ *
+ * @return bool False if the instruction set is not supported, the selection is then unchanged.
+ */
+bool select_isa(Isa isa);
+
+/**
+ * @brief Get the instruction set whose kernels are in use.
+ */
+Isa active_isa();
+
+/**
+ * @brief Parse an instruction set name (generic, sse4.2, avx2, avx512).
+ *
+ * @return bool False if the name is unknown.
+ */
+bool parse_isa(const std::string &name, Isa &isa);
+
+/**
+ * @brief Get the name of an instruction set, e.g. "AVX2".
+ */
+std::string isa_name(Isa isa);
+
+#endif // SIMD_KERNELS_H
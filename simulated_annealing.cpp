@@ -1,114 +1,347 @@
 #include "simulated_annealing.h"
 #include "cooling_strategies.h"
 #include "flow_shop.h"
-#include <iostream>
+#include "no_wait.h"
+#include "sequence_evaluator.h"
+#include <chrono>
+#include <climits>
+#include <stdexcept>
+#include <thread>
 
-double probability(int t_star, int f_st, int temp) {
-    double expon = static_cast<double>(t_star - f_st) / temp;
+double probability(int t_star, int f_st, double temp) {
+    if (temp <= 0) {
+        return 0;
+    }
+    double expon = static_cast<double>(f_st - t_star) / temp;
     return std::exp(-expon);
 }
 
-std::vector<int> simulated_annealing_tsum(const std::vector<std::vector<int>> &jobs, const std::vector<int> &s,
-                                          ObjectFunctionResult (*object_f)(const std::vector<std::vector<int>> &,
-                                                                           const std::vector<int> &, int, int,
-                                                                           const std::vector<int> &), int iterations,
-                                          int neighbors, int t0, int jobs_num, int machines_num, int cooling_strategy,
-                                          const std::vector<int> &deadlines) {
+static int objective_value(const ObjectFunctionResult &result, Objective objective) {
+    return objective == Objective::t_sum ? result.t_sum : result.c_max;
+}
+
+// True if object_f alone gives the objective value of an order; it computes the makespan and the total
+// tardiness in 32 bits, so both have to fit there, which value_bound tells
+static bool object_function_value(Objective objective, const ObjectiveContext &context, long long value_bound) {
+    return context.setups == nullptr && value_bound <= INT_MAX &&
+           (objective == Objective::c_max || objective == Objective::t_sum || objective == Objective::no_wait_c_max);
+}
+
+static std::vector<int> anneal(Objective objective, const std::vector<std::vector<int>> &jobs,
+                               const std::vector<int> &s, ObjectFunction object_f, int iterations, int neighbors,
+                               int t0, int jobs_num, int machines_num, int cooling_strategy,
+                               const std::vector<int> &deadlines, const AnnealingOptions &options,
+                               AnnealingStats *stats) {
+    auto start_time = std::chrono::steady_clock::now();
     std::vector<int> s_best = s;  // stores the best order of jobs
     int t = 0;  // represents time
+    long long cost = 0;  // evaluated (position, machine) cells
+    std::mt19937 rng(options.seed != 0 ? options.seed : std::random_device()());
+    std::vector<std::unique_ptr<MoveOperator>> operators;
+    for (MoveType type: options.moves) {
+        operators.push_back(make_move_operator(type));
+    }
+    if (operators.empty()) {
+        operators.push_back(make_move_operator(MoveType::swap));
+    }
+    AdaptiveOperatorSelector selector(operators.size());
+    ObjectiveContext context;
+    context.setups = objective == Objective::no_wait_c_max ? nullptr : options.setups;
+    context.job_weights = options.job_weights;
+    context.combination = options.combination;
+    if (objective == Objective::no_wait_c_max) {
+        // one matrix serves the evaluator, the calibration workers and the polisher
+        context.delays = std::make_shared<const DelayMatrix>(jobs, jobs_num, machines_num,
+                                                             std::max(1u, std::thread::hardware_concurrency()));
+    }
+    SequenceEvaluator evaluator(jobs, jobs_num, machines_num, deadlines, objective, &context);
+    context.width = evaluator.time_width();
+    bool fast_value = object_function_value(
+            objective, context, tardiness_bound(completion_time_bound(jobs, jobs_num, machines_num), deadlines));
+    // full evaluation of an order; object_f knows nothing of setup times, job weights or the other criteria
+    auto full_value = [&](const std::vector<int> &order) {
+        return !fast_value
+               ? evaluator.rebase(order)
+               : objective_value(object_f(jobs, order, jobs_num, machines_num, deadlines), objective);
+    };
+    std::unique_ptr<EvaluationCache> own_cache;
+    EvaluationCache *cache = options.shared_cache;
+    if (cache == nullptr && options.cache_size > 0) {
+        own_cache.reset(new EvaluationCache(options.cache_size));
+        cache = own_cache.get();
+    }
+    PermutationHasher hasher(cache != nullptr ? jobs_num : 0);
+    long long hits = 0, misses = 0, skips = 0, accepted_moves = 0;
+    long long horizon = static_cast<long long>(iterations) * neighbors;
+    double alpha = options.alpha;
+    int calibration_samples = 0;
+    bool calibrate = t0 <= 0;
+    CalibrationOptions calibration = options.calibration;
+    if (calibrate) {
+        calibration.seed = rng();
+    }
+    AdaptiveCooling adaptive(t0, horizon);
+    double schedule_t = 0;  // clock of the open-loop schedules, rewound by reheats
+    double temp = t0;
+    int reheats = 0;
+    std::vector<RestartEvent> restart_events;
+    std::unique_ptr<Polisher> polisher;
+    int polish_improvements = 0, polish_gain = 0;
+    if (options.polish.mode != PolishMode::off) {
+        PolishOptions polish = options.polish;
+        polish.seed = rng();
+        polisher.reset(new Polisher(jobs, machines_num, deadlines, objective, &context, polish));
+    }
     try {
-        int f_best = object_f(jobs, s_best, jobs_num, machines_num, deadlines).t_sum;  // stores the best Tsum
-        std::vector<int> s_base = s_best;
+        if (calibrate) {
+            Calibration calibrated = calibrate_temperature(jobs, s, jobs_num, machines_num, deadlines, objective,
+                                                           options.moves, cooling_strategy, horizon, alpha,
+                                                           calibration, &context);
+            t0 = std::max(1, static_cast<int>(std::lround(calibrated.t0)));
+            alpha = calibrated.alpha;
+            calibration_samples = calibrated.samples;
+            adaptive = AdaptiveCooling(t0, horizon);
+            temp = t0;
+        }
+        int f_best = full_value(s_best);
+        // the working order is mutated in place, it holds the base order between neighbors
+        std::vector<int> s_work = s_best;
         int f_base = f_best;
-        double alpha = 0.8;  // alpha (should be between 0.8 - 0.9)
-        for (int i = 0; i < iterations; ++i) {
-            std::vector<int> s_best_neighbor = s_base;
+        MoveJournal journal;  // moves applied to the working order since the base order
+        MoveJournal best_neighbor;  // moves leading from the base order to the best neighbor
+        int stagnant_epochs = 0;
+        const RestartOptions &restart = options.restart;
+        ElitePool elite(restart.elite_size);
+        int epochs_since_best = 0;
+        int segment_best = f_best;  // best value since the last restart
+        // a single job has no neighbors
+        for (int i = 0; i < iterations && f_best > options.lower_bound && jobs_num > 1; ++i) {
+            if (options.time_limit > 0 &&
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count() >=
+                options.time_limit) {
+                break;
+            }
+            int f_best_before = f_best;
+            long long accepted_before = accepted_moves;
+            best_neighbor.clear();
             int f_best_neighbor = f_base;
+            evaluator.rebase(s_work);
+            if (cache != nullptr) {
+                cache->insert(hasher.rebase(s_work), f_base);
+            }
             for (int j = 0; j < neighbors; ++j) {
                 ++t;
-                std::vector<int> s_neighbor = s_base;
-                int a = rand() % s.size();
-                int b = rand() % s.size();
-                std::swap(s_neighbor[a], s_neighbor[b]);
-                int f_neighbor = object_f(jobs, s_neighbor, jobs_num, machines_num, deadlines).t_sum;
+                ++schedule_t;
+                int op = options.adaptive_moves
+                         ? selector.select(rng)
+                         : std::uniform_int_distribution<int>(0, operators.size() - 1)(rng);
+                Move move = operators[op]->sample(jobs_num, rng);
+                int f_neighbor;
+                long long move_cost = 0;
+                bool cached = false;
+                if (cache != nullptr) {
+                    uint64_t key = hasher.hash_after(move);
+                    if (options.tabu_filter && cache->contains(key)) {
+                        ++skips;
+                        continue;
+                    }
+                    journal.apply(s_work, move);
+                    if (cache->lookup(key, f_neighbor)) {
+                        ++hits;
+                        cached = true;
+                    } else {
+                        ++misses;
+                        f_neighbor = operators[op]->evaluate(evaluator, s_work, move);
+                        move_cost = evaluator.last_cost();
+                        cache->insert(key, f_neighbor);
+                    }
+                } else {
+                    journal.apply(s_work, move);
+                    f_neighbor = operators[op]->evaluate(evaluator, s_work, move);
+                    move_cost = evaluator.last_cost();
+                }
+                cost += move_cost;
+                // a cached value cost nothing to evaluate, crediting it would favor the operators revisiting orders
+                if (options.adaptive_moves && !cached) {
+                    selector.reward(op, f_base - f_neighbor, move_cost);
+                }
+                if (stats != nullptr) {
+                    ++stats->move_uses[static_cast<int>(move.type)];
+                    stats->move_improvements[static_cast<int>(move.type)] += f_neighbor < f_base;
+                }
                 // -- START SIMULATED ANNEALING --
+                bool accepted = false;
+                if (cooling_strategy == ADAPTIVE_COOLING) {
+                    temp = adaptive.temperature();
+                }
                 if (f_neighbor < f_best_neighbor) {
-                    f_best_neighbor = f_neighbor;
-                    s_best_neighbor = s_neighbor;
+                    accepted = true;
                 } else {
-                    int temp = choose_cooling_strategy(cooling_strategy, f_best_neighbor, f_neighbor, t0, alpha, t);
-                    double prob = probability(f_best_neighbor, f_neighbor, temp);
-                    int randProb = rand() % 99;
-                    if (randProb < prob * 100) {
-                        f_best_neighbor = f_neighbor;
-                        s_best_neighbor = s_neighbor;
+                    if (cooling_strategy != ADAPTIVE_COOLING) {
+                        temp = choose_cooling_strategy(cooling_strategy, f_best_neighbor, f_neighbor, t0, alpha,
+                                                       static_cast<int>(schedule_t));
                     }
+                    double prob = probability(f_best_neighbor, f_neighbor, temp);
+                    accepted = std::uniform_real_distribution<double>(0.0, 1.0)(rng) < prob;
+                }
+                if (cooling_strategy == ADAPTIVE_COOLING) {
+                    adaptive.record(accepted, t);
+                }
+                accepted_moves += accepted;
+                if (accepted) {
+                    f_best_neighbor = f_neighbor;
+                    best_neighbor.assign(journal);
                 }
+                journal.rollback(s_work);
                 // -- END SIMULATED ANNEALING --
+                if (f_best_neighbor <= options.lower_bound) {
+                    break;  // proven optimal, no neighbor can be better
+                }
             }
-            s_base = s_best_neighbor;
+            best_neighbor.replay(s_work);
             f_base = f_best_neighbor;
             if (f_base < f_best) {
                 f_best = f_base;
-                s_best = s_base;
+                s_best = s_work;  // the only full copy: a new global best
+                stagnant_epochs = 0;
+            } else if (options.reheat_after > 0 && ++stagnant_epochs >= options.reheat_after) {
+                adaptive.reheat(options.reheat_fraction);
+                schedule_t -= options.reheat_fraction * schedule_t;
+                stagnant_epochs = 0;
+                ++reheats;
             }
-
+            if (options.on_epoch && options.on_epoch(i, s_best, f_best, s_work, f_base) && f_base < f_best) {
+                f_best = f_base;
+                s_best = s_work;
+            }
+            // -- POLISHING --
+            if (polisher) {
+                if (options.polish.mode == PolishMode::best ? f_best < f_best_before
+                                                            : (i + 1) % std::max(1, options.polish.interval) == 0) {
+                    polisher->submit(options.polish.mode == PolishMode::best ? s_best : s_work,
+                                     options.polish.mode == PolishMode::best ? f_best : f_base);
+                }
+                std::vector<int> polished;
+                int f_polished;
+                if (polisher->take(polished, f_polished) && f_polished < f_base) {
+                    s_work.swap(polished);
+                    f_base = f_polished;
+                    ++polish_improvements;
+                    if (f_base < f_best) {
+                        f_best = f_base;
+                        s_best = s_work;
+                    }
+                }
+            }
+            if (restart.strategy == RestartStrategy::none) {
+                continue;
+            }
+            // -- STAGNATION DETECTION AND RESTARTS --
+            segment_best = std::min(segment_best, f_base);
+            epochs_since_best = f_best < f_best_before ? 0 : epochs_since_best + 1;
+            if (restart.strategy == RestartStrategy::elite && f_best < f_best_before) {
+                elite.offer(s_best, f_best);
+            }
+            double acceptance = static_cast<double>(accepted_moves - accepted_before) / neighbors;
+            bool stagnated = (restart.stagnation_epochs > 0 && epochs_since_best >= restart.stagnation_epochs) ||
+                             (restart.min_acceptance > 0 && acceptance < restart.min_acceptance);
+            if (stagnated && i + 1 < iterations) {
+                elite.offer(s_work, f_base);
+                if (!restart_events.empty()) {
+                    restart_events.back().best_after = segment_best;
+                }
+                s_work = restart_order(restart.strategy, objective, jobs, jobs_num, machines_num, deadlines, s_best,
+                                       elite, restart_events.size(), restart.kick_moves, rng);
+                f_base = full_value(s_work);
+                restart_events.push_back({t, i, restart.strategy, f_best, f_base, f_base});
+                segment_best = f_base;
+                if (f_base < f_best) {
+                    f_best = f_base;
+                    s_best = s_work;
+                }
+                adaptive.reheat(options.reheat_fraction);
+                schedule_t -= options.reheat_fraction * schedule_t;
+                epochs_since_best = 0;
+            }
+        }
+        if (!restart_events.empty()) {
+            restart_events.back().best_after = segment_best;
+        }
+        if (polisher) {
+            // the final descent: the search may have ended before its best order was polished
+            PolishWorkspace workspace;
+            int f_polished = insertion_local_search(jobs, machines_num, deadlines, objective, &context, s_best,
+                                                    f_best, workspace);
+            polish_gain = f_best - f_polished;
+            f_best = f_polished;
+        }
+        if (stats != nullptr) {
+            stats->best_value = f_best;
+            stats->reached_lower_bound = f_best <= options.lower_bound;
         }
     } catch (std::overflow_error &e) {
-        std::cout << "\n!!! Overflow Error - Exited at: " << t << "/" << iterations * neighbors << " !!!\n";
-        std::cerr << "Overflow error: " << e.what() << std::endl;
+        // the caller reports it; without statistics to report it through, it propagates
+        if (stats == nullptr) {
+            throw;
+        }
+        stats->overflow = e.what();
+    }
+    if (stats != nullptr) {
+        stats->evaluations = t;
+        stats->evaluation_cost = cost;
+        stats->cache_hits = hits;
+        stats->cache_misses = misses;
+        stats->tabu_skips = skips;
+        stats->accepted = accepted_moves;
+        stats->reheats = reheats;
+        stats->t0 = t0;
+        stats->alpha = alpha;
+        stats->calibration_samples = calibration_samples;
+        stats->restarts = restart_events;
+        stats->polish_runs = polisher ? polisher->runs() : 0;
+        stats->polish_improvements = polish_improvements;
+        stats->polish_gain = polish_gain;
+        stats->final_temperature = cooling_strategy == ADAPTIVE_COOLING ? adaptive.temperature() : temp;
     }
     return s_best;
 }
 
+std::vector<int> simulated_annealing(Objective objective, const std::vector<std::vector<int>> &jobs,
+                                     const std::vector<int> &s, ObjectFunction object_f, int iterations,
+                                     int neighbors, int t0, int jobs_num, int machines_num, int cooling_strategy,
+                                     const std::vector<int> &deadlines, const AnnealingOptions &options,
+                                     AnnealingStats *stats) {
+    return anneal(objective, jobs, s, object_f, iterations, neighbors, t0, jobs_num, machines_num,
+                  cooling_strategy, deadlines, options, stats);
+}
+
+std::vector<int> simulated_annealing_tsum(const std::vector<std::vector<int>> &jobs, const std::vector<int> &s,
+                                          ObjectFunctionResult (*object_f)(const std::vector<std::vector<int>> &,
+                                                                           const std::vector<int> &, int, int,
+                                                                           const std::vector<int> &), int iterations,
+                                          int neighbors, int t0, int jobs_num, int machines_num, int cooling_strategy,
+                                          const std::vector<int> &deadlines, const AnnealingOptions &options,
+                                          AnnealingStats *stats) {
+    return anneal(Objective::t_sum, jobs, s, object_f, iterations, neighbors, t0, jobs_num, machines_num,
+                  cooling_strategy, deadlines, options, stats);
+}
+
 std::vector<int> simulated_annealing_cmax(const std::vector<std::vector<int>> &jobs, const std::vector<int> &s,
                                           ObjectFunctionResult (*object_f)(const std::vector<std::vector<int>> &,
                                                                            const std::vector<int> &, int, int,
                                                                            const std::vector<int> &), int iterations,
                                           int neighbors, int t0, int jobs_num, int machines_num, int cooling_strategy,
-                                          const std::vector<int> &deadlines) {
-    std::vector<int> s_best = s;
-    int t = 0;  // represents time// stores the best order of jobs
-    try {
-        int f_best = object_f(jobs, s_best, jobs_num, machines_num, deadlines).c_max;  // stores the best Cmax
-        std::vector<int> s_base = s_best;
-        int f_base = f_best;
-        double alpha = 0.8;  // alpha (should be between 0.8 - 0.9)
-        for (int i = 0; i < iterations; ++i) {
-            std::vector<int> s_best_neighbor = s_base;
-            int f_best_neighbor = f_base;
-            for (int j = 0; j < neighbors; ++j) {
-                ++t;
-                std::vector<int> s_neighbor = s_base;
-                int a = rand() % s.size();
-                int b = rand() % s.size();
-                std::swap(s_neighbor[a], s_neighbor[b]);
-                int f_neighbor = object_f(jobs, s_neighbor, jobs_num, machines_num, deadlines).c_max;
-                // -- START SIMULATED ANNEALING --
-                if (f_neighbor < f_best_neighbor) {
-                    f_best_neighbor = f_neighbor;
-                    s_best_neighbor = s_neighbor;
-                } else {
-                    int temp = choose_cooling_strategy(cooling_strategy, f_best_neighbor, f_neighbor, t0, alpha, t);
-                    double prob = probability(f_best_neighbor, f_neighbor, temp);
-                    int randProb = rand() % 99;
-                    if (randProb < prob * 100) {
-                        f_best_neighbor = f_neighbor;
-                        s_best_neighbor = s_neighbor;
-                    }
-                }
-                // -- END SIMULATED ANNEALING --
-            }
-            s_base = s_best_neighbor;
-            f_base = f_best_neighbor;
-            if (f_base < f_best) {
-                f_best = f_base;
-                s_best = s_base;
-            }
-        }
-    } catch (std::overflow_error &e) {
-        std::cout << "\n!!! Overflow Error - Exited at: " << t << "/" << iterations * neighbors << " !!!\n";
-        std::cerr << "Overflow error: " << e.what() << std::endl;
-    }
-    return s_best;
-}
\ No newline at end of file
+                                          const std::vector<int> &deadlines, const AnnealingOptions &options,
+                                          AnnealingStats *stats) {
+    return anneal(Objective::c_max, jobs, s, object_f, iterations, neighbors, t0, jobs_num, machines_num,
+                  cooling_strategy, deadlines, options, stats);
+}
+
+std::vector<int> simulated_annealing_no_wait(const std::vector<std::vector<int>> &jobs, const std::vector<int> &s,
+                                             ObjectFunction object_f, int iterations, int neighbors, int t0,
+                                             int jobs_num, int machines_num, int cooling_strategy,
+                                             const std::vector<int> &deadlines, const AnnealingOptions &options,
+                                             AnnealingStats *stats) {
+    return anneal(Objective::no_wait_c_max, jobs, s, object_f, iterations, neighbors, t0, jobs_num, machines_num,
+                  cooling_strategy, deadlines, options, stats);
+}
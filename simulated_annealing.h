@@ -1,10 +1,18 @@
 #ifndef SIMULATED_ANNEALING_H
 #define SIMULATED_ANNEALING_H
 
+#include <functional>
+#include <string>
 #include <vector>
 #include "flow_shop.h"
 #include "cooling_strategies.h"
 #include "deadlines.h"
+#include "neighborhood.h"
+#include "evaluation_cache.h"
+#include "temperature_calibration.h"
+#include "restarts.h"
+#include "local_search.h"
+#include "setup_times.h"
 
 /**
  * @brief Struct representing the result of an objective function.
@@ -20,13 +28,133 @@ struct ObjectFunctionResult {
     std::vector<std::vector<int>> job_end;
 };
 
+/**
+ * @brief Struct representing the optional settings of the simulated annealing engine.
+ *
+ * This struct collects the settings that are not needed for a plain annealing run.
+ * A default constructed instance reproduces the original behaviour of the engine.
+ *
+ * - alpha: The cooling rate passed to the cooling strategy (usually between 0.8 and 0.99).
+ * - lower_bound: A lower bound of the objective. The search stops as soon as the
+ *   incumbent reaches it, since it is then proven optimal.
+ * - moves: The move operators neighbors are generated with.
+ * - adaptive_moves: If true, the operators are picked by an AdaptiveOperatorSelector,
+ *   otherwise uniformly at random.
+ * - seed: The seed of the random generator of the run, 0 picks a random seed.
+ * - cache_size: The number of slots of the evaluation cache, 0 disables the cache.
+ * - shared_cache: A cache shared with other runs on the same instance and objective,
+ *   used instead of a private cache of cache_size slots when not nullptr.
+ * - tabu_filter: If true, neighbors found in the cache are skipped instead of being
+ *   taken from it, so recently evaluated orders are not revisited.
+ * - reheat_after: The number of epochs without a new best order after which the
+ *   search is reheated, 0 never reheats.
+ * - reheat_fraction: How far a reheat goes back: the adaptive schedule closes this
+ *   fraction of the gap to t0, the other schedules rewind their clock by it.
+ * - calibration: The settings of the temperature calibration, which runs when the
+ *   initial temperature t0 is 0 or less; see calibrate_temperature(). Its seed is
+ *   replaced by the seed of the run.
+ * - restart: Stagnation detection and the restart strategy, see RestartOptions. A
+ *   restart reheats the schedule like a stagnation reheat.
+ * - polish: The settings of the polishing stage, see PolishOptions. Orders are polished
+ *   by iterated greedy in a background thread and the polished orders replace the
+ *   current order when they are better; a final insertion local search then polishes
+ *   the returned order. Its seed is replaced by a seed drawn from the run. The
+ *   hand-over depends on thread timing, so polished runs are not reproducible.
+ * - setups: Optional sequence-dependent setup times of the instance, must outlive the
+ *   run. With setups, the initial and restart orders are evaluated by the engine's
+ *   own evaluator instead of object_f, which has no setups. The no-wait objective
+ *   ignores them.
+ * - job_weights: The weights of the jobs in the weighted tardiness; missing weights are 1.
+ * - combination: The coefficients of Objective::weighted_sum, see CriteriaWeights. Like
+ *   with setups, the objectives besides c_max, t_sum and no_wait_c_max are evaluated
+ *   by the engine's own evaluator instead of object_f.
+ * - time_limit: The wall-clock budget of the run in seconds, 0 for none. The search
+ *   stops at the first epoch boundary past it; the calibration and the final polishing
+ *   count towards it but are not interrupted.
+ * - on_epoch: Called after every epoch with the epoch number, the best order and its
+ *   value, and the current order and its value. It may replace the current order
+ *   (e.g. with a migrant from another search) and then returns true; the value it
+ *   stores must be the objective value of the new order.
+ */
+struct AnnealingOptions {
+    double alpha = 0.8;
+    int lower_bound = 0;
+    std::vector<MoveType> moves = {MoveType::swap};
+    bool adaptive_moves = false;
+    unsigned seed = 0;
+    std::size_t cache_size = 0;
+    EvaluationCache *shared_cache = nullptr;
+    bool tabu_filter = false;
+    int reheat_after = 0;
+    double reheat_fraction = 0.5;
+    CalibrationOptions calibration;
+    RestartOptions restart;
+    PolishOptions polish;
+    const SetupTimes *setups = nullptr;
+    std::vector<int> job_weights;
+    CriteriaWeights combination;
+    double time_limit = 0;
+    std::function<bool(int epoch, const std::vector<int> &best, int best_value,
+                       std::vector<int> &current, int &current_value)> on_epoch;
+};
+
+/**
+ * @brief Struct representing the statistics collected during simulated annealing.
+ *
+ * - evaluations: The number of neighbors evaluated.
+ * - best_value: The objective value of the returned job order.
+ * - reached_lower_bound: True if the search stopped because the incumbent matched
+ *   the lower bound given in AnnealingOptions.
+ * - evaluation_cost: The number of (position, machine) cells computed by the evaluations.
+ * - move_uses: The number of neighbors generated with each move type, indexed by MoveType.
+ * - move_improvements: The number of neighbors of each move type that improved their base order.
+ * - cache_hits: The number of neighbors whose value was taken from the evaluation cache.
+ * - cache_misses: The number of neighbors looked up in the cache and evaluated.
+ * - tabu_skips: The number of neighbors skipped by the tabu filter.
+ * - accepted: The number of neighbors accepted as the best neighbor of their epoch.
+ * - reheats: The number of reheats after stagnation.
+ * - final_temperature: The temperature at the end of the run.
+ * - t0, alpha: The initial temperature and cooling rate used, after calibration.
+ * - calibration_samples: The number of neighbors evaluated by the calibration, 0 if
+ *   it did not run.
+ * - restarts: The telemetry of every restart, in order.
+ * - polish_runs: The number of orders the polishing thread finished.
+ * - polish_improvements: The number of polished orders that replaced the current order.
+ * - polish_gain: How much the final insertion local search improved the returned order.
+ * - overflow: The message of the overflow error that ended the run early, empty if the
+ *   run finished. best_value is then not set and the returned order is the best one
+ *   found before the error. A run without statistics throws the std::overflow_error.
+ */
+struct AnnealingStats {
+    long long evaluations = 0;
+    int best_value = 0;
+    bool reached_lower_bound = false;
+    long long evaluation_cost = 0;
+    std::vector<long long> move_uses = std::vector<long long>(MOVE_TYPE_COUNT, 0);
+    std::vector<long long> move_improvements = std::vector<long long>(MOVE_TYPE_COUNT, 0);
+    long long cache_hits = 0;
+    long long cache_misses = 0;
+    long long tabu_skips = 0;
+    long long accepted = 0;
+    int reheats = 0;
+    double final_temperature = 0;
+    int t0 = 0;
+    double alpha = 0;
+    int calibration_samples = 0;
+    std::vector<RestartEvent> restarts;
+    int polish_runs = 0;
+    int polish_improvements = 0;
+    int polish_gain = 0;
+    std::string overflow;
+};
+
 /**
  * @brief Calculate the probability of accepting a worse solution in simulated annealing.
  *
  * The function takes as input the best-known objective function value from a previous
  * iteration, the current objective function value, and the current temperature. It calculates
- * the probability of accepting a worse solution based on the temperature and the difference
- * between the current and best-known objective function values.
+ * the Metropolis probability exp(-(f_st - t_star) / temp) of accepting a worse solution,
+ * which is 0 at a non-positive temperature.
  *
  * @param t_star Best-known objective function value from a previous iteration.
  * @param f_st Current objective function value.
@@ -34,7 +162,7 @@ struct ObjectFunctionResult {
  *
  * @return double The calculated probability of accepting a worse solution.
  */
-double probability(int t_star, int f_st, int temp);
+double probability(int t_star, int f_st, double temp);
 
 
 using ObjectFunction = ObjectFunctionResult (*)(const std::vector<std::vector<int>> &,
@@ -51,17 +179,22 @@ using ObjectFunction = ObjectFunctionResult (*)(const std::vector<std::vector<in
  * the number of neighbors considered at each iteration, the initial temperature,
  * the number of jobs, the number of machines, the chosen cooling strategy, and deadlines.
  * It returns the best job order found during the simulated annealing process.
+ * The search stops early once the best makespan reaches options.lower_bound.
  *
  * @param jobs A 2D vector representing the processing times of jobs on each machine.
  * @param s An initial job order.
- * @param object_f A function to calculate the objective function result.
+ * @param object_f A function to calculate the objective function result of the initial order.
+ * Neighbors are evaluated incrementally by a SequenceEvaluator of the same objective.
  * @param iterations The number of iterations in the simulated annealing process.
  * @param neighbors The number of neighbors considered at each iteration.
- * @param t0 Initial temperature.
+ * @param t0 Initial temperature, 0 or less calibrates it (and alpha) from the start order.
  * @param jobs_num The total number of jobs.
  * @param machines_num The total number of machines.
- * @param cooling_strategy An integer representing the chosen cooling strategy.
+ * @param cooling_strategy An integer representing the chosen cooling strategy, see
+ * choose_cooling_strategy() and AdaptiveCooling (ADAPTIVE_COOLING).
  * @param deadlines A vector representing the deadlines for each job.
+ * @param options Optional settings of the engine, see AnnealingOptions.
+ * @param stats Optional output for the statistics of the run, may be nullptr.
  *
  * @return std::vector<int> The best job order found during simulated annealing.
  */
@@ -74,7 +207,9 @@ std::vector<int> simulated_annealing_cmax(const std::vector<std::vector<int>> &j
                                           int jobs_num,
                                           int machines_num,
                                           int cooling_strategy,
-                                          const std::vector<int> &deadlines);
+                                          const std::vector<int> &deadlines,
+                                          const AnnealingOptions &options = AnnealingOptions(),
+                                          AnnealingStats *stats = nullptr);
 
 /**
  * @brief Perform simulated annealing to find the best job order that minimizes total tardiness.
@@ -84,17 +219,23 @@ std::vector<int> simulated_annealing_cmax(const std::vector<std::vector<int>> &j
  * the number of neighbors considered at each iteration, the initial temperature,
  * the number of jobs, the number of machines, the chosen cooling strategy, and deadlines.
  * It returns the best job order found during the simulated annealing process.
+ * The search stops early once the best total tardiness reaches options.lower_bound,
+ * which by default is the trivial bound of zero tardiness.
  *
  * @param jobs A 2D vector representing the processing times of jobs on each machine.
  * @param s An initial job order.
- * @param object_f A function to calculate the objective function result.
+ * @param object_f A function to calculate the objective function result of the initial order.
+ * Neighbors are evaluated incrementally by a SequenceEvaluator of the same objective.
  * @param iterations The number of iterations in the simulated annealing process.
  * @param neighbors The number of neighbors considered at each iteration.
- * @param t0 Initial temperature.
+ * @param t0 Initial temperature, 0 or less calibrates it (and alpha) from the start order.
  * @param jobs_num The total number of jobs.
  * @param machines_num The total number of machines.
- * @param cooling_strategy An integer representing the chosen cooling strategy.
+ * @param cooling_strategy An integer representing the chosen cooling strategy, see
+ * choose_cooling_strategy() and AdaptiveCooling (ADAPTIVE_COOLING).
  * @param deadlines A vector representing the deadlines for each job.
+ * @param options Optional settings of the engine, see AnnealingOptions.
+ * @param stats Optional output for the statistics of the run, may be nullptr.
  *
  * @return std::vector<int> The best job order found during simulated annealing.
  */
@@ -107,6 +248,85 @@ std::vector<int> simulated_annealing_tsum(const std::vector<std::vector<int>> &j
                                           int jobs_num,
                                           int machines_num,
                                           int cooling_strategy,
-                                          const std::vector<int> &deadlines);
+                                          const std::vector<int> &deadlines,
+                                          const AnnealingOptions &options = AnnealingOptions(),
+                                          AnnealingStats *stats = nullptr);
+
+/**
+ * @brief Perform simulated annealing to find the best job order that minimizes the no-wait makespan.
+ *
+ * The engine is the same as for simulated_annealing_cmax(), but neighbors are
+ * evaluated on the no-wait objective: the evaluator precomputes the delay matrix of
+ * the instance once (see DelayMatrix), after which a swap, insertion or block move
+ * costs a constant number of delay lookups.
+ *
+ * @param jobs A 2D vector representing the processing times of jobs on each machine.
+ * @param s An initial job order.
+ * @param object_f A function to calculate the no-wait objective function result of the
+ * initial order, see no_wait_object_function().
+ * @param iterations The number of iterations in the simulated annealing process.
+ * @param neighbors The number of neighbors considered at each iteration.
+ * @param t0 Initial temperature, 0 or less calibrates it (and alpha) from the start order.
+ * @param jobs_num The total number of jobs.
+ * @param machines_num The total number of machines.
+ * @param cooling_strategy An integer representing the chosen cooling strategy, see
+ * choose_cooling_strategy() and AdaptiveCooling (ADAPTIVE_COOLING).
+ * @param deadlines A vector representing the deadlines for each job.
+ * @param options Optional settings of the engine, see AnnealingOptions.
+ * @param stats Optional output for the statistics of the run, may be nullptr.
+ *
+ * @return std::vector<int> The best job order found during simulated annealing.
+ */
+std::vector<int> simulated_annealing_no_wait(const std::vector<std::vector<int>> &jobs,
+                                             const std::vector<int> &s,
+                                             ObjectFunction object_f,
+                                             int iterations,
+                                             int neighbors,
+                                             int t0,
+                                             int jobs_num,
+                                             int machines_num,
+                                             int cooling_strategy,
+                                             const std::vector<int> &deadlines,
+                                             const AnnealingOptions &options = AnnealingOptions(),
+                                             AnnealingStats *stats = nullptr);
+
+/**
+ * @brief Perform simulated annealing on any objective of the registry.
+ *
+ * The common entry point of the engine, which the objective-specific functions above
+ * call with their objective; see objective_registry(). Besides the makespan, the
+ * total tardiness and the no-wait makespan, object_f cannot evaluate an objective,
+ * so the engine evaluates every order with its own SequenceEvaluator.
+ *
+ * @param objective The objective to minimize.
+ * @param jobs A 2D vector representing the processing times of jobs on each machine.
+ * @param s An initial job order.
+ * @param object_f A function to calculate the objective function result of the initial order.
+ * @param iterations The number of iterations in the simulated annealing process.
+ * @param neighbors The number of neighbors considered at each iteration.
+ * @param t0 Initial temperature, 0 or less calibrates it (and alpha) from the start order.
+ * @param jobs_num The total number of jobs.
+ * @param machines_num The total number of machines.
+ * @param cooling_strategy An integer representing the chosen cooling strategy, see
+ * choose_cooling_strategy() and AdaptiveCooling (ADAPTIVE_COOLING).
+ * @param deadlines A vector representing the deadlines for each job.
+ * @param options Optional settings of the engine, see AnnealingOptions.
+ * @param stats Optional output for the statistics of the run, may be nullptr.
+ *
+ * @return std::vector<int> The best job order found during simulated annealing.
+ */
+std::vector<int> simulated_annealing(Objective objective,
+                                     const std::vector<std::vector<int>> &jobs,
+                                     const std::vector<int> &s,
+                                     ObjectFunction object_f,
+                                     int iterations,
+                                     int neighbors,
+                                     int t0,
+                                     int jobs_num,
+                                     int machines_num,
+                                     int cooling_strategy,
+                                     const std::vector<int> &deadlines,
+                                     const AnnealingOptions &options = AnnealingOptions(),
+                                     AnnealingStats *stats = nullptr);
 
 #endif // SIMULATED_ANNEALING_H
@@ -0,0 +1,125 @@
+#include "solver.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include "flow_shop.h"
+#include "instance_generator.h"
+#include "lower_bound.h"
+#include "neh.h"
+#include "no_wait.h"
+#include "tardiness_seeds.h"
+
+bool Solver::load_instance(const std::string &path, std::string &error) {
+    Instance instance;
+    if (!::load_instance(path, instance)) {
+        error = "could not read the instance " + path;
+        return false;
+    }
+    if (instance.deadlines.empty()) {
+        generate_due_dates(instance, GeneratorOptions());
+    }
+    return set_instance(instance, error);
+}
+
+bool Solver::set_instance(const Instance &instance, std::string &error) {
+    if (!validate_instance(instance, error)) {
+        return false;
+    }
+    if (instance.deadlines.empty()) {
+        error = "the instance needs one due date per job";
+        return false;
+    }
+    instance_ = instance;
+    jobs_ = jobs_matrix(instance_);
+    setups_.reset(instance_.setups.empty() ? nullptr
+                                           : new SetupTimes(instance_.jobs_num, instance_.machines_num,
+                                                            instance_.setups));
+    loaded_ = true;
+    result_ = SolverResult();
+    return true;
+}
+
+void Solver::configure(const SolverConfig &config) {
+    config_ = config;
+}
+
+bool Solver::solve(const SolverCallback &on_progress, std::string &error) {
+    if (!loaded_) {
+        error = "no instance is loaded";
+        return false;
+    }
+    Objective objective = config_.objective;
+    bool no_wait = objective == Objective::no_wait_c_max;
+    if (no_wait && setups_ != nullptr) {
+        error = "the no-wait flow shop does not support setup times";
+        return false;
+    }
+    if (config_.iterations <= 0 || config_.neighbors <= 0 || config_.cooling_strategy < 1 ||
+        config_.cooling_strategy > 6) {
+        error = "the run needs positive iterations and neighbors and a cooling strategy from 1 to 6";
+        return false;
+    }
+    int n = instance_.jobs_num;
+    int m = instance_.machines_num;
+    const std::vector<int> &deadlines = instance_.deadlines;
+    AnnealingOptions options = config_.annealing;
+    options.setups = setups_.get();
+    options.job_weights = instance_.weights;
+    options.lower_bound = objective == Objective::c_max || no_wait
+                          ? taillard_lower_bound(jobs_, n, m).value
+                          : trivial_lower_bound(objective, options.combination);
+    if (on_progress) {
+        // the caller's hook runs after the one of the given options, which may replace the current order
+        auto hook = options.on_epoch;
+        options.on_epoch = [hook, &on_progress](int epoch, const std::vector<int> &best, int best_value,
+                                                std::vector<int> &current, int &current_value) {
+            bool replaced = hook && hook(epoch, best, best_value, current, current_value);
+            on_progress(epoch, best, best_value);
+            return replaced;
+        };
+    }
+
+    std::vector<int> start;
+    if (config_.constructive_start) {
+        NehOptions neh_options;
+        neh_options.threads = std::max(1u, std::thread::hardware_concurrency());
+        ObjectiveContext context;
+        context.setups = options.setups;
+        context.job_weights = options.job_weights;
+        context.combination = options.combination;
+        start = objective_info(objective).due_dates ? best_tardiness_seed(jobs_, n, m, deadlines, objective, &context)
+                                                    : neh(jobs_, n, m, neh_options);
+    } else {
+        start.resize(n);
+        for (int j = 0; j < n; ++j) {
+            start[j] = j + 1;
+        }
+        std::shuffle(start.begin(), start.end(), std::mt19937(options.seed));
+    }
+
+    ObjectFunction object_f = no_wait ? no_wait_object_function : object_function;
+    SolverResult result;
+    auto start_time = std::chrono::steady_clock::now();
+    result.order = simulated_annealing(objective, jobs_, start, object_f, config_.iterations, config_.neighbors,
+                                       config_.t0, n, m, config_.cooling_strategy, deadlines, options, &result.stats);
+    if (!result.stats.overflow.empty()) {
+        error = result.stats.overflow;
+        return false;
+    }
+    result.runtime_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    result.value = result.stats.best_value;
+    try {
+        ObjectFunctionResult schedule = setups_ != nullptr
+                                        ? setup_object_function(jobs_, *setups_, result.order, n, m, deadlines)
+                                        : object_f(jobs_, result.order, n, m, deadlines);
+        result.criteria = schedule_criteria(schedule.job_end, result.order, deadlines, instance_.weights);
+    } catch (std::overflow_error &e) {
+        // the objective fits, a criterion it does not weight may not
+        error = e.what();
+        return false;
+    }
+    result_ = result;
+    return true;
+}
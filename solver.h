@@ -0,0 +1,130 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "instance.h"
+#include "objectives.h"
+#include "setup_times.h"
+#include "simulated_annealing.h"
+
+/**
+ * @brief Struct representing the settings of a Solver run.
+ *
+ * - objective: The objective to minimize, see objective_registry().
+ * - iterations: The number of epochs of the annealing.
+ * - neighbors: The number of neighbors evaluated per epoch.
+ * - t0: The initial temperature, 0 calibrates it.
+ * - cooling_strategy: The cooling strategy, numbered as in the command line menu (1 to 6).
+ * - constructive_start: If true, the run starts from NEH, or from the best due-date rule
+ *   for the due-date objectives; otherwise from a random order drawn from the seed.
+ * - annealing: The settings of the engine. The lower bound, the setup times and the job
+ *   weights are taken from the instance and the objective.
+ */
+struct SolverConfig {
+    Objective objective = Objective::t_sum;
+    int iterations = 1000;
+    int neighbors = 10;
+    int t0 = 0;
+    int cooling_strategy = 3;
+    bool constructive_start = true;
+    AnnealingOptions annealing;
+};
+
+/**
+ * @brief Struct representing the outcome of a Solver run.
+ *
+ * - order: The best job order found (1-based job numbers).
+ * - value: The objective value of the order.
+ * - criteria: Every criterion of the order, see CriteriaValues.
+ * - stats: The statistics of the annealing.
+ * - runtime_seconds: The wall-clock time of the run.
+ */
+struct SolverResult {
+    std::vector<int> order;
+    int value = 0;
+    CriteriaValues criteria;
+    AnnealingStats stats;
+    double runtime_seconds = 0;
+};
+
+/**
+ * @brief Progress callback of Solver::solve(): the epoch, the best order and its value.
+ */
+using SolverCallback = std::function<void(int epoch, const std::vector<int> &best, int best_value)>;
+
+/**
+ * @brief Solves flow-shop instances in-process.
+ *
+ * The entry point of the solver library: load an instance, configure a run, solve
+ * it and fetch the result. A Solver is reused for any number of runs; the instance
+ * data the engine needs (jobs matrix, setup times) is prepared once per instance.
+ * One Solver must not be used by several threads at once, separate Solvers may.
+ */
+class Solver {
+public:
+    /**
+     * @brief Load an instance from a binary instance file, see load_instance().
+     *
+     * Instances without due dates get generated ones, as on the command line.
+     *
+     * @param path The path of the file.
+     * @param error Output for the reason of a failure.
+     *
+     * @return bool True if the instance was loaded.
+     */
+    bool load_instance(const std::string &path, std::string &error);
+
+    /**
+     * @brief Use an instance held in memory.
+     *
+     * @param instance The instance, copied.
+     * @param error Output for the reason of a failure.
+     *
+     * @return bool True if the instance is valid.
+     */
+    bool set_instance(const Instance &instance, std::string &error);
+
+    /**
+     * @brief Replace the settings of the following runs.
+     */
+    void configure(const SolverConfig &config);
+
+    /**
+     * @brief Run the annealing on the instance.
+     *
+     * @param on_progress Called after every epoch, may be empty.
+     * @param error Output for the reason of a failure.
+     *
+     * @return bool True if the run finished; its outcome is then available from result().
+     * False for invalid settings and when an objective value does not fit into an int.
+     */
+    bool solve(const SolverCallback &on_progress, std::string &error);
+
+    /**
+     * @brief Get the instance of the runs.
+     */
+    const Instance &instance() const { return instance_; }
+
+    /**
+     * @brief Get the settings of the runs.
+     */
+    const SolverConfig &config() const { return config_; }
+
+    /**
+     * @brief Get the outcome of the last finished run.
+     */
+    const SolverResult &result() const { return result_; }
+
+private:
+    Instance instance_;
+    bool loaded_ = false;
+    std::vector<std::vector<int>> jobs_;
+    std::unique_ptr<SetupTimes> setups_;
+    SolverConfig config_;
+    SolverResult result_;
+};
+
+#endif // SOLVER_H
@@ -0,0 +1,126 @@
+#include "solver_c.h"
+#include <algorithm>
+#include <new>
+#include "solver.h"
+
+struct sa_solver {
+    Solver solver;
+    SolverConfig config;
+    std::string error;
+};
+
+// Runs a step of the C interface; exceptions must not cross it, they become a failure
+template<typename F>
+static int guarded(sa_solver *solver, F step) {
+    try {
+        solver->error.clear();
+        return step() ? 0 : -1;
+    } catch (const std::exception &exception) {
+        solver->error = exception.what();
+    } catch (...) {
+        solver->error = "unknown error";
+    }
+    return -1;
+}
+
+sa_solver *sa_solver_create(void) {
+    return new(std::nothrow) sa_solver();
+}
+
+void sa_solver_destroy(sa_solver *solver) {
+    delete solver;
+}
+
+int sa_solver_load_instance(sa_solver *solver, const char *path) {
+    return guarded(solver, [&]() {
+        return solver->solver.load_instance(path != nullptr ? path : "", solver->error);
+    });
+}
+
+int sa_solver_set_instance(sa_solver *solver, int jobs_num, int machines_num, const int *processing,
+                           const int *deadlines, const int *weights) {
+    return guarded(solver, [&]() {
+        if (jobs_num <= 0 || machines_num <= 0 || processing == nullptr || deadlines == nullptr) {
+            solver->error = "the instance needs jobs, machines, processing times and due dates";
+            return false;
+        }
+        Instance instance;
+        instance.name = "embedded";
+        instance.jobs_num = jobs_num;
+        instance.machines_num = machines_num;
+        instance.processing.assign(processing, processing + static_cast<std::size_t>(jobs_num) * machines_num);
+        instance.deadlines.assign(deadlines, deadlines + jobs_num);
+        if (weights != nullptr) {
+            instance.weights.assign(weights, weights + jobs_num);
+        }
+        return solver->solver.set_instance(instance, solver->error);
+    });
+}
+
+int sa_solver_set_objective(sa_solver *solver, const char *name) {
+    return guarded(solver, [&]() {
+        if (name == nullptr || !parse_objective(name, solver->config.objective)) {
+            solver->error = "unknown objective";
+            return false;
+        }
+        return true;
+    });
+}
+
+int sa_solver_set_criteria_weights(sa_solver *solver, const char *weights) {
+    return guarded(solver, [&]() {
+        if (weights == nullptr || !parse_criteria_weights(weights, solver->config.annealing.combination)) {
+            solver->error = "invalid weights, use name:coefficient pairs such as c_max:1,t_sum:2";
+            return false;
+        }
+        return true;
+    });
+}
+
+int sa_solver_set_schedule(sa_solver *solver, int iterations, int neighbors, int t0, int cooling_strategy) {
+    return guarded(solver, [&]() {
+        if (iterations <= 0 || neighbors <= 0 || cooling_strategy < 1 || cooling_strategy > 6) {
+            solver->error = "the run needs positive iterations and neighbors and a cooling strategy from 1 to 6";
+            return false;
+        }
+        solver->config.iterations = iterations;
+        solver->config.neighbors = neighbors;
+        solver->config.t0 = t0;
+        solver->config.cooling_strategy = cooling_strategy;
+        return true;
+    });
+}
+
+void sa_solver_set_seed(sa_solver *solver, unsigned seed) {
+    solver->config.annealing.seed = seed;
+}
+
+int sa_solver_solve(sa_solver *solver, sa_progress_callback on_progress, void *user_data) {
+    return guarded(solver, [&]() {
+        SolverCallback callback;
+        if (on_progress != nullptr) {
+            callback = [on_progress, user_data](int epoch, const std::vector<int> &, int best_value) {
+                on_progress(epoch, best_value, user_data);
+            };
+        }
+        solver->solver.configure(solver->config);
+        return solver->solver.solve(callback, solver->error);
+    });
+}
+
+int sa_solver_result_value(const sa_solver *solver) {
+    return solver->solver.result().value;
+}
+
+int sa_solver_result_order(const sa_solver *solver, int *order, int capacity) {
+    const std::vector<int> &best = solver->solver.result().order;
+    int length = best.size();
+    if (order != nullptr && capacity >= length) {
+        std::copy(best.begin(), best.end(), order);
+    }
+    return length;
+}
+
+const char *sa_solver_error(const sa_solver *solver) {
+    return solver->error.c_str();
+}
@@ -0,0 +1,114 @@
+#ifndef SOLVER_C_H
+#define SOLVER_C_H
+
+/*
+ * C interface of the solver library, for embedding it in programs that are not C++.
+ * It wraps the Solver class (solver.h); every function that can fail returns 0 on
+ * success and -1 on failure, with the reason available from sa_solver_error().
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Opaque handle of a solver.
+ */
+typedef struct sa_solver sa_solver;
+
+/**
+ * @brief Progress callback: the epoch, the best objective value so far and the user data.
+ */
+typedef void (*sa_progress_callback)(int epoch, int best_value, void *user_data);
+
+/**
+ * @brief Create a solver with the default settings, see SolverConfig.
+ *
+ * @return sa_solver* The solver, NULL if out of memory.
+ */
+sa_solver *sa_solver_create(void);
+
+/**
+ * @brief Destroy a solver, NULL is ignored.
+ */
+void sa_solver_destroy(sa_solver *solver);
+
+/**
+ * @brief Load an instance from a binary instance file.
+ */
+int sa_solver_load_instance(sa_solver *solver, const char *path);
+
+/**
+ * @brief Use an instance given as arrays, which are copied.
+ *
+ * @param solver The solver.
+ * @param jobs_num The total number of jobs.
+ * @param machines_num The total number of machines.
+ * @param processing The processing times, machine-major: job j on machine i at i * jobs_num + j.
+ * @param deadlines The due date of every job.
+ * @param weights The weight of every job, NULL for an unweighted instance.
+ */
+int sa_solver_set_instance(sa_solver *solver, int jobs_num, int machines_num, const int *processing,
+                           const int *deadlines, const int *weights);
+
+/**
+ * @brief Set the objective by name, e.g. "c_max" or "t_sum", see objective_registry().
+ */
+int sa_solver_set_objective(sa_solver *solver, const char *name);
+
+/**
+ * @brief Set the coefficients of the weighted_sum objective, e.g. "c_max:1,t_sum:2".
+ */
+int sa_solver_set_criteria_weights(sa_solver *solver, const char *weights);
+
+/**
+ * @brief Set the annealing schedule.
+ *
+ * @param solver The solver.
+ * @param iterations The number of epochs.
+ * @param neighbors The number of neighbors evaluated per epoch.
+ * @param t0 The initial temperature, 0 calibrates it.
+ * @param cooling_strategy The cooling strategy, 1 to 6 as in the command line menu.
+ */
+int sa_solver_set_schedule(sa_solver *solver, int iterations, int neighbors, int t0, int cooling_strategy);
+
+/**
+ * @brief Set the seed of the runs, 0 picks a random seed.
+ */
+void sa_solver_set_seed(sa_solver *solver, unsigned seed);
+
+/**
+ * @brief Run the annealing on the instance.
+ *
+ * @param solver The solver.
+ * @param on_progress Called after every epoch, may be NULL.
+ * @param user_data Passed to the callback.
+ */
+int sa_solver_solve(sa_solver *solver, sa_progress_callback on_progress, void *user_data);
+
+/**
+ * @brief Get the objective value of the last finished run.
+ */
+int sa_solver_result_value(const sa_solver *solver);
+
+/**
+ * @brief Copy the best order of the last finished run (1-based job numbers).
+ *
+ * @param solver The solver.
+ * @param order Output for the order, may be NULL to query the length.
+ * @param capacity The number of entries order holds.
+ *
+ * @return int The length of the order; the order is copied only if capacity holds all of it.
+ */
+int sa_solver_result_order(const sa_solver *solver, int *order, int capacity);
+
+/**
+ * @brief Get the reason of the last failure, an empty string if there was none.
+ */
+const char *sa_solver_error(const sa_solver *solver);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SOLVER_C_H
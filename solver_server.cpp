@@ -0,0 +1,754 @@
+#include "solver_server.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "instance_generator.h"
+#include "solver.h"
+
+static const char REQUEST_MAGIC[] = "SAR1";
+static const char RESPONSE_MAGIC[] = "SAS1";
+
+enum class ResponseStatus {
+    ok,
+    error,
+    busy
+};
+
+static std::atomic<bool> stop_requested(false);
+
+static void request_stop(int) {
+    stop_requested = true;
+}
+
+// A parsed JSON value; numbers are kept as doubles, which hold every int exactly
+struct JsonValue {
+    enum class Type {
+        null,
+        boolean,
+        number,
+        string,
+        array,
+        object
+    };
+    Type type = Type::null;
+    double number = 0;
+    std::string text;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> members;
+
+    const JsonValue *member(const std::string &name) const {
+        for (const auto &entry: members) {
+            if (entry.first == name) {
+                return &entry.second;
+            }
+        }
+        return nullptr;
+    }
+};
+
+// Recursive-descent parser of the JSON the requests use; \u escapes are not supported
+class JsonParser {
+public:
+    explicit JsonParser(const std::string &text) : text_(text), pos_(0) {}
+
+    bool parse(JsonValue &value) {
+        if (!parse_value(value, 0)) {
+            return false;
+        }
+        skip_space();
+        return pos_ == text_.size();
+    }
+
+private:
+    // nesting deeper than any request needs is rejected instead of exhausting the stack
+    static const int MAX_DEPTH = 16;
+
+    void skip_space() {
+        while (pos_ < text_.size() && std::strchr(" \t\r\n", text_[pos_]) != nullptr) {
+            ++pos_;
+        }
+    }
+
+    bool consume(char c) {
+        skip_space();
+        if (pos_ < text_.size() && text_[pos_] == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    bool parse_string(std::string &out) {
+        if (!consume('"')) {
+            return false;
+        }
+        out.clear();
+        while (pos_ < text_.size() && text_[pos_] != '"') {
+            char c = text_[pos_++];
+            if (c == '\\') {
+                if (pos_ >= text_.size()) {
+                    return false;
+                }
+                char escaped = text_[pos_++];
+                const char *from = "\"\\/bfnrt";
+                const char *to = "\"\\/\b\f\n\r\t";
+                const char *found = std::strchr(from, escaped);
+                if (found == nullptr || escaped == '\0') {
+                    return false;
+                }
+                c = to[found - from];
+            }
+            out += c;
+        }
+        return consume('"');
+    }
+
+    bool parse_value(JsonValue &value, int depth) {
+        skip_space();
+        if (pos_ >= text_.size() || depth > MAX_DEPTH) {
+            return false;
+        }
+        char c = text_[pos_];
+        if (c == '{') {
+            value.type = JsonValue::Type::object;
+            ++pos_;
+            if (consume('}')) {
+                return true;
+            }
+            do {
+                std::pair<std::string, JsonValue> entry;
+                if (!parse_string(entry.first) || !consume(':') || !parse_value(entry.second, depth + 1)) {
+                    return false;
+                }
+                value.members.push_back(std::move(entry));
+            } while (consume(','));
+            return consume('}');
+        } else if (c == '[') {
+            value.type = JsonValue::Type::array;
+            ++pos_;
+            if (consume(']')) {
+                return true;
+            }
+            do {
+                value.items.emplace_back();
+                if (!parse_value(value.items.back(), depth + 1)) {
+                    return false;
+                }
+            } while (consume(','));
+            return consume(']');
+        } else if (c == '"') {
+            value.type = JsonValue::Type::string;
+            return parse_string(value.text);
+        } else if (text_.compare(pos_, 4, "true") == 0 || text_.compare(pos_, 5, "false") == 0) {
+            value.type = JsonValue::Type::boolean;
+            value.number = c == 't' ? 1 : 0;
+            pos_ += c == 't' ? 4 : 5;
+            return true;
+        } else if (text_.compare(pos_, 4, "null") == 0) {
+            pos_ += 4;
+            return true;
+        }
+        const char *start = text_.c_str() + pos_;
+        char *end;
+        value.type = JsonValue::Type::number;
+        value.number = std::strtod(start, &end);
+        pos_ += end - start;
+        return end != start;
+    }
+
+    const std::string &text_;
+    std::size_t pos_;
+};
+
+static std::string json_escape(const std::string &text) {
+    std::string escaped;
+    for (char c: text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", c);
+            escaped += code;
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+// An int read from a JSON number, false if it is missing, not a number or not integral
+static bool json_int(const JsonValue *value, int &out) {
+    if (value == nullptr || value->type != JsonValue::Type::number || !std::isfinite(value->number) ||
+        value->number < INT_MIN ||
+        value->number > INT_MAX || value->number != static_cast<int>(value->number)) {
+        return false;
+    }
+    out = static_cast<int>(value->number);
+    return true;
+}
+
+static bool json_ints(const JsonValue *value, std::vector<int> &out) {
+    out.clear();
+    if (value == nullptr || value->type != JsonValue::Type::array) {
+        return false;
+    }
+    for (const JsonValue &item: value->items) {
+        out.emplace_back();
+        if (!json_int(&item, out.back())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct Connection {
+    int fd;
+    std::mutex write_mutex;
+    std::atomic<bool> finished;
+
+    explicit Connection(int socket) : fd(socket), finished(false) {}
+
+    ~Connection() { close(fd); }
+
+    // Frames of concurrent responses must not interleave
+    bool send_frame(const std::string &payload) {
+        std::lock_guard<std::mutex> lock(write_mutex);
+        uint32_t length = htonl(static_cast<uint32_t>(payload.size()));
+        std::string frame(reinterpret_cast<const char *>(&length), sizeof(length));
+        frame += payload;
+        std::size_t sent = 0;
+        while (sent < frame.size()) {
+            ssize_t written = send(fd, frame.data() + sent, frame.size() - sent, MSG_NOSIGNAL);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            } else if (written <= 0) {
+                return false;
+            }
+            sent += written;
+        }
+        return true;
+    }
+};
+
+static bool read_full(int fd, char *buffer, std::size_t size) {
+    std::size_t received = 0;
+    while (received < size) {
+        ssize_t count = recv(fd, buffer + received, size - received, 0);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        } else if (count <= 0) {
+            return false;
+        }
+        received += count;
+    }
+    return true;
+}
+
+// One change of a delta: 1-based job and machine, machine 0 for the due date
+struct DeltaChange {
+    int job;
+    int machine;
+    int value;
+};
+
+struct Request {
+    bool json = true;
+    std::string id = "null";  // the id as JSON text, echoed in the response
+    int binary_id = 0;
+    std::string instance_id;
+    Objective objective = Objective::t_sum;
+    CriteriaWeights combination;
+    int budget_ms = 0;
+    int iterations = 2000;
+    int neighbors = 20;
+    unsigned seed = 0;
+    std::unique_ptr<Instance> instance;  // a full instance, or nullptr for a delta
+    std::vector<DeltaChange> delta;
+    std::shared_ptr<const Instance> resolved;  // the instance to solve, set before queueing
+};
+
+struct Task {
+    std::shared_ptr<Connection> connection;
+    std::shared_ptr<Request> request;
+};
+
+// Named instances for delta requests, most recently used first
+class InstanceCache {
+public:
+    explicit InstanceCache(int capacity) : capacity_(std::max(1, capacity)) {}
+
+    std::shared_ptr<const Instance> find(const std::string &key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+            if (it->first == key) {
+                entries_.splice(entries_.begin(), entries_, it);
+                return it->second;
+            }
+        }
+        return nullptr;
+    }
+
+    void store(const std::string &key, const std::shared_ptr<const Instance> &instance) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.remove_if([&key](const Entry &entry) { return entry.first == key; });
+        entries_.emplace_front(key, instance);
+        if (static_cast<int>(entries_.size()) > capacity_) {
+            entries_.pop_back();
+        }
+    }
+
+private:
+    using Entry = std::pair<std::string, std::shared_ptr<const Instance>>;
+    int capacity_;
+    std::mutex mutex_;
+    std::list<Entry> entries_;
+};
+
+// Bounded queue between the connections and the workers; a full queue rejects instead of blocking
+class TaskQueue {
+public:
+    explicit TaskQueue(int capacity) : capacity_(std::max(1, capacity)), closed_(false) {}
+
+    bool try_push(Task task) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_ || static_cast<int>(tasks_.size()) >= capacity_) {
+            return false;
+        }
+        tasks_.push_back(std::move(task));
+        ready_.notify_one();
+        return true;
+    }
+
+    bool pop(Task &task) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [this]() { return closed_ || !tasks_.empty(); });
+        if (tasks_.empty()) {
+            return false;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        ready_.notify_all();
+    }
+
+private:
+    int capacity_;
+    bool closed_;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<Task> tasks_;
+};
+
+static bool parse_json_instance(const JsonValue &value, Instance &instance, std::string &error) {
+    instance.name = "request";
+    if (!json_int(value.member("jobs"), instance.jobs_num) ||
+        !json_int(value.member("machines"), instance.machines_num) ||
+        !json_ints(value.member("processing"), instance.processing)) {
+        error = "the instance needs jobs, machines and processing";
+        return false;
+    }
+    if ((value.member("due_dates") != nullptr && !json_ints(value.member("due_dates"), instance.deadlines)) ||
+        (value.member("weights") != nullptr && !json_ints(value.member("weights"), instance.weights)) ||
+        (value.member("setups") != nullptr && !json_ints(value.member("setups"), instance.setups))) {
+        error = "due_dates, weights and setups must be arrays of integers";
+        return false;
+    }
+    return true;
+}
+
+static bool parse_json_delta(const JsonValue &value, std::vector<DeltaChange> &delta, std::string &error) {
+    const char *fields[] = {"processing", "due_dates"};
+    for (const char *field: fields) {
+        const JsonValue *changes = value.member(field);
+        if (changes == nullptr) {
+            continue;
+        }
+        bool due_dates = std::strcmp(field, "due_dates") == 0;
+        std::vector<int> change;
+        if (changes->type != JsonValue::Type::array) {
+            error = std::string(field) + " of a delta must be an array";
+            return false;
+        }
+        for (const JsonValue &item: changes->items) {
+            if (!json_ints(&item, change) || change.size() != (due_dates ? 2u : 3u)) {
+                error = due_dates ? "due date changes are [job, due]" : "processing changes are [job, machine, time]";
+                return false;
+            }
+            delta.push_back(due_dates ? DeltaChange{change[0], 0, change[1]}
+                                      : DeltaChange{change[0], change[1], change[2]});
+        }
+    }
+    return true;
+}
+
+static bool parse_json_request(const std::string &payload, Request &request, std::string &error) {
+    JsonValue root;
+    if (!JsonParser(payload).parse(root) || root.type != JsonValue::Type::object) {
+        error = "the request is not a JSON object";
+        return false;
+    }
+    const JsonValue *id = root.member("id");
+    if (id != nullptr && id->type == JsonValue::Type::number) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.17g", id->number);
+        request.id = text;
+    } else if (id != nullptr && id->type == JsonValue::Type::string) {
+        request.id = "\"" + json_escape(id->text) + "\"";
+    }
+    const JsonValue *objective = root.member("objective");
+    if (objective != nullptr &&
+        (objective->type != JsonValue::Type::string || !parse_objective(objective->text, request.objective))) {
+        error = "unknown objective";
+        return false;
+    }
+    const JsonValue *weights = root.member("weights");
+    if (weights != nullptr &&
+        (weights->type != JsonValue::Type::string || !parse_criteria_weights(weights->text, request.combination))) {
+        error = "invalid weights, use name:coefficient pairs such as c_max:1,t_sum:2";
+        return false;
+    }
+    const JsonValue *instance_id = root.member("instance_id");
+    if (instance_id != nullptr && instance_id->type == JsonValue::Type::string) {
+        request.instance_id = instance_id->text;
+    }
+    int seed = 0;
+    if ((root.member("budget_ms") != nullptr && !json_int(root.member("budget_ms"), request.budget_ms)) ||
+        (root.member("iterations") != nullptr && !json_int(root.member("iterations"), request.iterations)) ||
+        (root.member("neighbors") != nullptr && !json_int(root.member("neighbors"), request.neighbors)) ||
+        (root.member("seed") != nullptr && !json_int(root.member("seed"), seed))) {
+        error = "budget_ms, iterations, neighbors and seed must be integers";
+        return false;
+    }
+    request.seed = seed;
+    const JsonValue *instance = root.member("instance");
+    const JsonValue *delta = root.member("delta");
+    if (instance != nullptr && instance->type == JsonValue::Type::object) {
+        request.instance.reset(new Instance());
+        return parse_json_instance(*instance, *request.instance, error);
+    } else if (delta != nullptr && delta->type == JsonValue::Type::object) {
+        return parse_json_delta(*delta, request.delta, error);
+    }
+    error = "the request needs an instance or a delta object";
+    return false;
+}
+
+static bool parse_binary_request(const std::string &payload, Request &request, std::string &error) {
+    const std::size_t header = 4 + 7 * sizeof(int32_t);
+    int32_t fields[7];
+    if (payload.size() < header || payload.compare(0, 4, REQUEST_MAGIC) != 0) {
+        error = "unknown request format";
+        return false;
+    }
+    std::memcpy(fields, payload.data() + 4, sizeof(fields));
+    request.json = false;
+    request.binary_id = fields[0];
+    const std::vector<ObjectiveInfo> &registry = objective_registry();
+    if (fields[1] < 0 || fields[1] >= static_cast<int32_t>(registry.size())) {
+        error = "unknown objective";
+        return false;
+    }
+    request.objective = registry[fields[1]].objective;
+    request.budget_ms = fields[2];
+    request.iterations = fields[3];
+    request.seed = fields[4];
+    request.instance_id = fields[5] != 0 ? std::to_string(fields[5]) : "";
+    if (fields[6] == 0) {
+        // the rest of the frame is a binary instance file
+        std::string body = payload.substr(header);
+        std::FILE *file = fmemopen(&body[0], body.size(), "rb");
+        request.instance.reset(new Instance());
+        request.instance->name = "request";
+        bool valid = file != nullptr && read_instance_binary(file, *request.instance);
+        if (file != nullptr) {
+            std::fclose(file);
+        }
+        if (!valid) {
+            error = "invalid binary instance";
+        }
+        return valid;
+    }
+    int32_t count = 0;
+    if (payload.size() >= header + sizeof(count)) {
+        std::memcpy(&count, payload.data() + header, sizeof(count));
+    }
+    if (fields[6] != 1 || count < 0 ||
+        payload.size() != header + sizeof(count) + static_cast<std::size_t>(count) * 3 * sizeof(int32_t)) {
+        error = "invalid delta";
+        return false;
+    }
+    const char *changes = payload.data() + header + sizeof(count);
+    for (int32_t k = 0; k < count; ++k) {
+        int32_t change[3];
+        std::memcpy(change, changes + k * sizeof(change), sizeof(change));
+        request.delta.push_back({change[0], change[1], change[2]});
+    }
+    return true;
+}
+
+// The instance a request solves: its own, or the named one of an earlier request with the delta applied
+static bool resolve_instance(Request &request, InstanceCache &cache, std::string &error) {
+    if (request.instance != nullptr) {
+        if (!validate_instance(*request.instance, error)) {
+            return false;
+        }
+        if (request.instance->deadlines.empty()) {
+            generate_due_dates(*request.instance, GeneratorOptions());
+        }
+        request.resolved = std::shared_ptr<const Instance>(request.instance.release());
+    } else {
+        std::shared_ptr<const Instance> base = request.instance_id.empty() ? nullptr : cache.find(request.instance_id);
+        if (base == nullptr) {
+            error = "a delta needs the instance_id of an earlier request";
+            return false;
+        }
+        // the cached instance may still be solved by a worker, the delta goes into a copy
+        std::shared_ptr<Instance> changed = std::make_shared<Instance>(*base);
+        int n = changed->jobs_num;
+        int m = changed->machines_num;
+        for (const DeltaChange &change: request.delta) {
+            if (change.job < 1 || change.job > n || change.machine < 0 || change.machine > m) {
+                error = "a delta refers to a job or machine the instance does not have";
+                return false;
+            }
+            if (change.machine == 0) {
+                changed->deadlines[change.job - 1] = change.value;
+            } else {
+                changed->processing[(change.machine - 1) * n + change.job - 1] = change.value;
+            }
+        }
+        if (!validate_instance(*changed, error)) {
+            return false;
+        }
+        request.resolved = changed;
+    }
+    if (!request.instance_id.empty()) {
+        cache.store(request.instance_id, request.resolved);
+    }
+    return true;
+}
+
+static std::string response(const Request &request, ResponseStatus status, const std::string &error,
+                            const SolverResult *result) {
+    if (!request.json) {
+        std::string payload(RESPONSE_MAGIC, 4);
+        int32_t fields[4] = {request.binary_id, static_cast<int32_t>(status),
+                             result != nullptr ? result->value : 0,
+                             result != nullptr ? static_cast<int32_t>(result->order.size()) : 0};
+        payload.append(reinterpret_cast<const char *>(fields), sizeof(fields));
+        if (result != nullptr) {
+            payload.append(reinterpret_cast<const char *>(result->order.data()), result->order.size() * sizeof(int));
+        } else if (status == ResponseStatus::error) {
+            int32_t length = error.size();
+            payload.append(reinterpret_cast<const char *>(&length), sizeof(length));
+            payload += error;
+        }
+        return payload;
+    }
+    const char *names[] = {"ok", "error", "busy"};
+    std::string payload = "{\"id\":" + request.id + ",\"status\":\"" + names[static_cast<int>(status)] + "\"";
+    if (result != nullptr) {
+        const CriteriaValues &criteria = result->criteria;
+        payload += ",\"value\":" + std::to_string(result->value) + ",\"order\":[";
+        for (std::size_t p = 0; p < result->order.size(); ++p) {
+            payload += (p > 0 ? "," : "") + std::to_string(result->order[p]);
+        }
+        char tail[320];
+        std::snprintf(tail, sizeof(tail),
+                      "],\"criteria\":{\"c_max\":%d,\"t_sum\":%d,\"flowtime\":%d,\"weighted_tardiness\":%d,"
+                      "\"max_lateness\":%d,\"tardy_jobs\":%d},\"runtime\":%.6f",
+                      criteria.c_max, criteria.t_sum, criteria.flowtime, criteria.weighted_tardiness,
+                      criteria.max_lateness, criteria.tardy_jobs, result->runtime_seconds);
+        payload += tail;
+    } else if (status == ResponseStatus::error) {
+        payload += ",\"error\":\"" + json_escape(error) + "\"";
+    }
+    return payload + "}";
+}
+
+// A worker keeps its Solver, and the instance loaded into it, from one request to the next
+static void work(TaskQueue &queue) {
+    Solver solver;
+    std::shared_ptr<const Instance> loaded;
+    Task task;
+    while (queue.pop(task)) {
+        const Request &request = *task.request;
+        std::string error;
+        bool solved = true;
+        if (loaded != request.resolved) {
+            solved = solver.set_instance(*request.resolved, error);
+            loaded = solved ? request.resolved : nullptr;
+        }
+        if (solved) {
+            SolverConfig config;
+            config.objective = request.objective;
+            config.iterations = request.iterations;
+            config.neighbors = request.neighbors;
+            config.annealing.seed = request.seed;
+            config.annealing.combination = request.combination;
+            config.annealing.time_limit = request.budget_ms / 1000.0;
+            solver.configure(config);
+            solved = solver.solve(SolverCallback(), error);
+        }
+        task.connection->send_frame(solved ? response(request, ResponseStatus::ok, "", &solver.result())
+                                           : response(request, ResponseStatus::error, error, nullptr));
+        task = Task();
+    }
+}
+
+// Reads the requests of one client; the workers answer them, parse errors and a full queue are answered here
+static void serve_connection(std::shared_ptr<Connection> connection, TaskQueue &queue, InstanceCache &cache,
+                             std::size_t max_request_bytes) {
+    uint32_t length;
+    while (read_full(connection->fd, reinterpret_cast<char *>(&length), sizeof(length))) {
+        length = ntohl(length);
+        if (length > max_request_bytes) {
+            break;
+        }
+        std::string payload(length, '\0');
+        if (!read_full(connection->fd, &payload[0], length)) {
+            break;
+        }
+        std::shared_ptr<Request> request = std::make_shared<Request>();
+        std::string error;
+        bool valid = false;
+        // a request too large to hold, or any other failure while reading it, is answered and the connection kept
+        try {
+            valid = !payload.empty() && payload[0] == '{' ? parse_json_request(payload, *request, error)
+                                                          : parse_binary_request(payload, *request, error);
+            if (valid && request->objective == Objective::weighted_sum && !has_criteria(request->combination)) {
+                error = "the weighted_sum objective needs weights";
+                valid = false;
+            }
+            valid = valid && resolve_instance(*request, cache, error);
+        } catch (std::exception &e) {
+            error = std::string("the request could not be read: ") + e.what();
+            valid = false;
+        }
+        if (!valid) {
+            connection->send_frame(response(*request, ResponseStatus::error, error, nullptr));
+        } else if (!queue.try_push({connection, request})) {
+            connection->send_frame(response(*request, ResponseStatus::busy, "", nullptr));
+        }
+    }
+    connection->finished = true;
+}
+
+static int listen_socket(const std::string &path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Invalid socket path " << path << std::endl;
+        return -1;
+    }
+    std::strcpy(address.sun_path, path.c_str());
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        std::cerr << "Could not create the socket: " << std::strerror(errno) << std::endl;
+        return -1;
+    }
+    // a socket left behind by an earlier run is replaced, any other file is not touched
+    struct stat existing;
+    if (stat(path.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode)) {
+        unlink(path.c_str());
+    }
+    if (bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || listen(fd, SOMAXCONN) != 0) {
+        std::cerr << "Could not listen on " << path << ": " << std::strerror(errno) << std::endl;
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int run_server(const ServerOptions &options) {
+    int listener = listen_socket(options.socket_path);
+    if (listener < 0) {
+        return 1;
+    }
+    stop_requested = false;
+    std::signal(SIGINT, request_stop);
+    std::signal(SIGTERM, request_stop);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    TaskQueue queue(options.queue_capacity);
+    InstanceCache cache(options.cached_instances);
+    int workers = options.workers > 0 ? options.workers : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> pool;
+    for (int w = 0; w < workers; ++w) {
+        pool.emplace_back(work, std::ref(queue));
+    }
+    std::cout << "Listening on " << options.socket_path << " with " << workers << " workers" << std::endl;
+
+    struct Client {
+        std::shared_ptr<Connection> connection;
+        std::thread thread;
+    };
+    std::list<Client> clients;
+    while (!stop_requested) {
+        // the timeout bounds how long a stop request waits
+        pollfd ready = {listener, POLLIN, 0};
+        int events = poll(&ready, 1, 200);
+        for (auto it = clients.begin(); it != clients.end();) {
+            if (it->connection->finished) {
+                it->thread.join();
+                it = clients.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if (events <= 0) {
+            continue;
+        }
+        int fd = accept(listener, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+        if (static_cast<int>(clients.size()) >= options.max_connections) {
+            close(fd);
+            continue;
+        }
+        std::shared_ptr<Connection> connection = std::make_shared<Connection>(fd);
+        clients.push_back({connection, std::thread(serve_connection, connection, std::ref(queue), std::ref(cache),
+                                                   options.max_request_bytes)});
+    }
+
+    close(listener);
+    unlink(options.socket_path.c_str());
+    for (Client &client: clients) {
+        shutdown(client.connection->fd, SHUT_RDWR);
+        client.thread.join();
+    }
+    queue.close();
+    for (std::thread &worker: pool) {
+        worker.join();
+    }
+    std::cout << "Server stopped" << std::endl;
+    return 0;
+}
@@ -0,0 +1,67 @@
+#ifndef SOLVER_SERVER_H
+#define SOLVER_SERVER_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Struct representing the settings of the solver daemon.
+ *
+ * - socket_path: The path of the Unix domain socket to listen on; an existing socket
+ *   file at the path is replaced.
+ * - workers: The number of worker threads solving requests, 0 for one per hardware thread.
+ * - queue_capacity: The number of requests that may wait for a worker. Further requests
+ *   are answered with the busy status right away, so clients can back off.
+ * - max_connections: The number of clients connected at once; further ones are closed.
+ * - cached_instances: The number of named instances kept for delta requests; the least
+ *   recently used one is dropped first.
+ * - max_request_bytes: The largest request frame accepted, larger ones close the connection.
+ */
+struct ServerOptions {
+    std::string socket_path;
+    int workers = 0;
+    int queue_capacity = 64;
+    int max_connections = 64;
+    int cached_instances = 64;
+    std::size_t max_request_bytes = 64u << 20;
+};
+
+/**
+ * @brief Run the solver daemon until SIGINT or SIGTERM.
+ *
+ * Clients send frames of a 4-byte big-endian length followed by the payload, and get
+ * one response frame per request, in completion order; responses carry the id of
+ * their request. A payload starting with '{' is a JSON request, answered in JSON:
+ *
+ *     {"id": 7, "instance_id": "line-2", "objective": "t_sum", "budget_ms": 200,
+ *      "iterations": 2000, "neighbors": 20, "seed": 1, "weights": "c_max:1,t_sum:2",
+ *      "instance": {"jobs": 3, "machines": 2, "processing": [...], "due_dates": [...],
+ *                   "weights": [...], "setups": [...]}}
+ *
+ * The instance arrays use the layout of Instance (processing machine-major). Instead of
+ * an instance, a request may carry a delta against the named instance of an earlier
+ * request, with 1-based job and machine numbers:
+ *
+ *     "delta": {"processing": [[job, machine, time], ...], "due_dates": [[job, due], ...]}
+ *
+ * The response is {"id": 7, "status": "ok", "value": ..., "order": [...], "criteria":
+ * {...}, "runtime": seconds}, or carries the status "error" with an "error" message,
+ * or "busy" when the queue is full.
+ *
+ * Any other payload is a binary request: the magic "SAR1" and the int32 fields id,
+ * objective (index into objective_registry()), budget_ms, iterations, seed, instance
+ * key (0 for none) and kind. Kind 0 is followed by an instance in the binary instance
+ * format, kind 1 by an int32 count and count (job, machine, value) triples of a delta,
+ * where machine 0 changes the due date. The binary response is "SAS1" with the int32
+ * fields id, status (0 ok, 1 error, 2 busy), value and jobs_num, followed by the order,
+ * or on error by the message length and the message.
+ *
+ * All integers inside payloads are in host byte order, as in the binary instance format.
+ *
+ * @param options The daemon settings, see ServerOptions.
+ *
+ * @return int The exit code: 0 after a signal, 1 if the socket could not be set up.
+ */
+int run_server(const ServerOptions &options);
+
+#endif // SOLVER_SERVER_H
@@ -0,0 +1,207 @@
+#include "tardiness_seeds.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include "time_width.h"
+
+// Insertion positions of NEH-EDD evaluated in full, the ones with the lowest estimate
+static const int NEH_EDD_CANDIDATES = 32;
+
+int total_tardiness(const std::vector<std::vector<int>> &jobs, int machines_num, const std::vector<int> &sequence,
+                    const std::vector<int> &deadlines, TardinessWorkspace &workspace) {
+    workspace.state.assign(machines_num, 0);
+    int t_sum = 0;
+    for (int job: sequence) {
+        int c = append_job(jobs[job - 1].data(), nullptr, machines_num, workspace.state.data());
+        t_sum += std::max(0, c - deadlines[job - 1]);
+    }
+    return t_sum;
+}
+
+static std::vector<int> sort_by_keys(int jobs_num, TardinessWorkspace &workspace) {
+    std::vector<int> order(jobs_num);
+    for (int j = 0; j < jobs_num; ++j) {
+        order[j] = j + 1;
+    }
+    const std::vector<int> &keys = workspace.keys;
+    std::stable_sort(order.begin(), order.end(), [&keys](int a, int b) {
+        return keys[a - 1] < keys[b - 1];
+    });
+    return order;
+}
+
+// Greedy dispatching: repeatedly appends the unscheduled job with the smallest priority
+static std::vector<int> dispatch(TardinessRule rule, const std::vector<std::vector<int>> &jobs, int jobs_num,
+                                 int machines_num, const std::vector<int> &deadlines,
+                                 TardinessWorkspace &workspace) {
+    workspace.state.assign(machines_num, 0);
+    workspace.candidate.resize(machines_num);
+    workspace.scheduled.assign(jobs_num, 0);
+    std::vector<int> order;
+    order.reserve(jobs_num);
+    for (int step = 0; step < jobs_num; ++step) {
+        int best_job = -1;
+        int best_priority = std::numeric_limits<int>::max();
+        for (int j = 0; j < jobs_num; ++j) {
+            if (workspace.scheduled[j]) {
+                continue;
+            }
+            std::copy(workspace.state.begin(), workspace.state.end(), workspace.candidate.begin());
+            int c = append_job(jobs[j].data(), nullptr, machines_num, workspace.candidate.data());
+            int priority = rule == TardinessRule::mdd ? std::max(c, deadlines[j]) : deadlines[j] - c;
+            if (priority < best_priority) {
+                best_priority = priority;
+                best_job = j;
+            }
+        }
+        append_job(jobs[best_job].data(), nullptr, machines_num, workspace.state.data());
+        workspace.scheduled[best_job] = 1;
+        order.push_back(best_job + 1);
+    }
+    return order;
+}
+
+static std::vector<int> neh_edd(const std::vector<std::vector<int>> &jobs, int jobs_num, int machines_num,
+                                const std::vector<int> &deadlines, TardinessWorkspace &workspace) {
+    workspace.keys.assign(deadlines.begin(), deadlines.begin() + jobs_num);
+    std::vector<int> priority = sort_by_keys(jobs_num, workspace);
+
+    std::vector<int> sequence;
+    sequence.reserve(jobs_num);
+    workspace.prefix_tardiness.resize(jobs_num + 1);
+    workspace.tardy_jobs.resize(jobs_num + 1);
+    workspace.state.resize(machines_num);
+    std::vector<int> &estimates = workspace.estimates;
+    std::vector<int> &positions = workspace.positions;
+    const std::vector<int> &head = workspace.taillard.head;
+    const int last = machines_num - 1;
+    std::mt19937 rng;  // the first-position tie-breaking draws no numbers
+    for (int job: priority) {
+        int k = sequence.size();
+        int stride = k + 1;
+        int deadline = deadlines[job - 1];
+        // the heads, and the makespan and completion time of the job at every position, in O(k * m)
+        taillard_insertion(jobs, machines_num, sequence, job, NehTieBreaking::first, rng, 1, workspace.taillard);
+        const std::vector<int> &makespan = workspace.taillard.makespan;
+        const std::vector<int> &front = workspace.taillard.front;
+        workspace.prefix_tardiness[0] = 0;
+        workspace.tardy_jobs[0] = 0;
+        for (int p = 0; p < k; ++p) {
+            int lateness = head[last * stride + p] - deadlines[sequence[p] - 1];
+            workspace.prefix_tardiness[p + 1] = workspace.prefix_tardiness[p] + std::max(0, lateness);
+            workspace.tardy_jobs[p + 1] = workspace.tardy_jobs[p] + (lateness > 0 ? 1 : 0);
+        }
+        int t_old = workspace.prefix_tardiness[k];
+        int c_max = k > 0 ? head[last * stride + k - 1] : 0;
+
+        // estimate: the tardy jobs behind the position are delayed by the growth of the makespan
+        estimates.resize(stride);
+        positions.resize(stride);
+        for (int pos = 0; pos <= k; ++pos) {
+            long long estimate = t_old + std::max(0, front[pos] - deadline) +
+                                 static_cast<long long>(workspace.tardy_jobs[k] - workspace.tardy_jobs[pos]) *
+                                 (makespan[pos] - c_max);
+            estimates[pos] = static_cast<int>(std::min<long long>(estimate, std::numeric_limits<int>::max()));
+            positions[pos] = pos;
+        }
+        // only the most promising positions are evaluated in full, O(k * m) each
+        int candidates = std::min(stride, NEH_EDD_CANDIDATES);
+        std::partial_sort(positions.begin(), positions.begin() + candidates, positions.end(),
+                          [&estimates](int a, int b) {
+                              return estimates[a] < estimates[b] || (estimates[a] == estimates[b] && a < b);
+                          });
+
+        int best_position = k;
+        int best_t_sum = std::numeric_limits<int>::max();
+        for (int r = 0; r < candidates; ++r) {
+            int pos = positions[r];
+            int tardiness = std::max(0, front[pos] - deadline);
+            // the jobs behind the position are only delayed, so the position cannot beat t_old plus the job
+            if (t_old + tardiness > best_t_sum) {
+                continue;
+            }
+            int t_sum = workspace.prefix_tardiness[pos] + tardiness;
+            int *state = workspace.state.data();
+            for (int i = 0; i < machines_num; ++i) {
+                state[i] = pos > 0 ? head[i * stride + pos - 1] : 0;
+            }
+            append_job(jobs[job - 1].data(), nullptr, machines_num, state);
+            // the suffix only adds tardiness, so stop once the position cannot win
+            for (int p = pos; p < k && t_sum <= best_t_sum; ++p) {
+                int c = append_job(jobs[sequence[p] - 1].data(), nullptr, machines_num, state);
+                t_sum += std::max(0, c - deadlines[sequence[p] - 1]);
+            }
+            // ties go to the earlier position, as in a scan from the front
+            if (t_sum < best_t_sum || (t_sum == best_t_sum && pos < best_position)) {
+                best_t_sum = t_sum;
+                best_position = pos;
+            }
+        }
+        sequence.insert(sequence.begin() + best_position, job);
+    }
+    return sequence;
+}
+
+std::vector<int> tardiness_seed(TardinessRule rule, const std::vector<std::vector<int>> &jobs, int jobs_num,
+                                int machines_num, const std::vector<int> &deadlines, TardinessWorkspace &workspace) {
+    if (rule == TardinessRule::edd) {
+        workspace.keys.assign(deadlines.begin(), deadlines.begin() + jobs_num);
+        return sort_by_keys(jobs_num, workspace);
+    } else if (rule == TardinessRule::slack) {
+        workspace.keys.resize(jobs_num);
+        for (int j = 0; j < jobs_num; ++j) {
+            int total = 0;
+            for (int i = 0; i < machines_num; ++i) {
+                total += jobs[j][i];
+            }
+            workspace.keys[j] = deadlines[j] - total;
+        }
+        return sort_by_keys(jobs_num, workspace);
+    } else if (rule == TardinessRule::mdd || rule == TardinessRule::dynamic_slack) {
+        return dispatch(rule, jobs, jobs_num, machines_num, deadlines, workspace);
+    }
+    return neh_edd(jobs, jobs_num, machines_num, deadlines, workspace);
+}
+
+std::vector<int> best_tardiness_seed(const std::vector<std::vector<int>> &jobs, int jobs_num, int machines_num,
+                                     const std::vector<int> &deadlines, Objective objective,
+                                     const ObjectiveContext *context, TardinessRule *best_rule) {
+    const TardinessRule rules[] = {TardinessRule::edd, TardinessRule::slack, TardinessRule::mdd,
+                                   TardinessRule::dynamic_slack, TardinessRule::neh_edd};
+    TardinessWorkspace workspace;
+    std::vector<int> best;
+    int best_value = std::numeric_limits<int>::max();
+    for (TardinessRule rule: rules) {
+        std::vector<int> order = tardiness_seed(rule, jobs, jobs_num, machines_num, deadlines, workspace);
+        int value = std::numeric_limits<int>::max();
+        try {
+            value = evaluate_order(jobs, machines_num, deadlines, objective, context, order, workspace.state);
+        } catch (std::overflow_error &) {
+            // the order still seeds the run if no rule fits, the annealing reports the overflow
+        }
+        if (best.empty() || value < best_value) {
+            best_value = value;
+            best = order;
+            if (best_rule != nullptr) {
+                *best_rule = rule;
+            }
+        }
+    }
+    return best;
+}
+
+std::string tardiness_rule_name(TardinessRule rule) {
+    std::string name;
+    if (rule == TardinessRule::edd) {
+        name = "Earliest Due Date";
+    } else if (rule == TardinessRule::slack) {
+        name = "Minimum Slack";
+    } else if (rule == TardinessRule::mdd) {
+        name = "Modified Due Date";
+    } else if (rule == TardinessRule::dynamic_slack) {
+        name = "Dynamic Slack";
+    } else if (rule == TardinessRule::neh_edd) {
+        name = "NEH-EDD";
+    }
+    return name;
+}
@@ -0,0 +1,120 @@
+#ifndef TARDINESS_SEEDS_H
+#define TARDINESS_SEEDS_H
+
+#include <vector>
+#include <string>
+#include "neh.h"
+#include "objectives.h"
+
+/**
+ * @brief Constructive rules for building a job order with low total tardiness.
+ *
+ * - edd: Earliest due date first. O(n log n).
+ * - slack: Smallest static slack (deadline minus total processing time) first. O(n log n).
+ * - mdd: Modified due date; repeatedly appends the job with the smallest
+ *   max(completion time if appended, deadline). O(n^2 * m).
+ * - dynamic_slack: Repeatedly appends the job with the smallest slack between its
+ *   deadline and its completion time if appended. O(n^2 * m).
+ * - neh_edd: NEH with jobs taken in EDD order, each inserted at the position that
+ *   minimizes the total tardiness of the partial sequence. taillard_insertion()
+ *   gives the makespan of every position in O(n * m); from it the tardiness of each
+ *   position is estimated, and only a fixed number of the most promising positions
+ *   are evaluated in full. O(n^2 * m).
+ */
+enum class TardinessRule {
+    edd,
+    slack,
+    mdd,
+    dynamic_slack,
+    neh_edd
+};
+
+/**
+ * @brief Struct holding the scratch buffers of the tardiness heuristics.
+ *
+ * The buffers are sized on first use and reused afterwards, so the rules can be
+ * run repeatedly (e.g. all of them, or once per restart) without allocating.
+ */
+struct TardinessWorkspace {
+    std::vector<int> state;
+    std::vector<int> candidate;
+    TaillardWorkspace taillard;
+    std::vector<int> prefix_tardiness;
+    std::vector<int> tardy_jobs;
+    std::vector<int> keys;
+    std::vector<int> estimates;
+    std::vector<int> positions;
+    std::vector<char> scheduled;
+};
+
+/**
+ * @brief Calculate the total tardiness of a job order.
+ *
+ * @param jobs A 2D vector representing the processing times of jobs on each machine.
+ * @param machines_num The total number of machines.
+ * @param sequence The job order (1-based job numbers), may be a partial order.
+ * @param deadlines A vector representing the deadlines for each job.
+ * @param workspace Scratch buffers reused between calls.
+ *
+ * @return int The sum of the tardiness of the jobs in the order.
+ */
+int total_tardiness(const std::vector<std::vector<int>> &jobs,
+                    int machines_num,
+                    const std::vector<int> &sequence,
+                    const std::vector<int> &deadlines,
+                    TardinessWorkspace &workspace);
+
+/**
+ * @brief Build a job order with a due-date-aware constructive rule.
+ *
+ * @param rule The constructive rule to apply, see TardinessRule.
+ * @param jobs A 2D vector representing the processing times of jobs on each machine.
+ * @param jobs_num The total number of jobs.
+ * @param machines_num The total number of machines.
+ * @param deadlines A vector representing the deadlines for each job.
+ * @param workspace Scratch buffers reused between calls.
+ *
+ * @return std::vector<int> The constructed job order (1-based job numbers).
+ */
+std::vector<int> tardiness_seed(TardinessRule rule,
+                                const std::vector<std::vector<int>> &jobs,
+                                int jobs_num,
+                                int machines_num,
+                                const std::vector<int> &deadlines,
+                                TardinessWorkspace &workspace);
+
+/**
+ * @brief Build a job order with every tardiness rule and keep the best one.
+ *
+ * The orders are ranked by the objective that is optimized, so the rule that suits
+ * e.g. the weighted tardiness or the maximum lateness wins over the one with the
+ * lowest total tardiness. An order whose value does not fit into an int ranks last.
+ *
+ * @param jobs A 2D vector representing the processing times of jobs on each machine.
+ * @param jobs_num The total number of jobs.
+ * @param machines_num The total number of machines.
+ * @param deadlines A vector representing the deadlines for each job.
+ * @param objective The objective the orders are ranked by.
+ * @param context The job weights, setup times and combination of the objective, may be nullptr.
+ * @param best_rule Optional output for the rule that produced the returned order, may be nullptr.
+ *
+ * @return std::vector<int> The job order with the lowest objective value.
+ */
+std::vector<int> best_tardiness_seed(const std::vector<std::vector<int>> &jobs,
+                                     int jobs_num,
+                                     int machines_num,
+                                     const std::vector<int> &deadlines,
+                                     Objective objective,
+                                     const ObjectiveContext *context,
+                                     TardinessRule *best_rule = nullptr);
+
+/**
+ * @brief Get the name of a tardiness rule.
+ *
+ * @param rule The tardiness rule.
+ *
+ * @return std::string The name of the rule.
+ */
+std::string tardiness_rule_name(TardinessRule rule);
+
+#endif // TARDINESS_SEEDS_H
@@ -0,0 +1,119 @@
+#include "temperature_calibration.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+// Mean acceptance probability of the uphill deltas at a temperature
+static double mean_acceptance(const std::vector<double> &deltas, double temperature) {
+    double sum = 0;
+    for (double delta: deltas) {
+        sum += std::exp(-delta / temperature);
+    }
+    return sum / deltas.size();
+}
+
+static double fit_alpha(int cooling_strategy, double t0, double final_temperature, double horizon, double alpha) {
+    if (cooling_strategy == 1 || cooling_strategy == 5) {
+        return (t0 / final_temperature - 1) / horizon;
+    } else if (cooling_strategy == 2) {
+        return (t0 / final_temperature - 1) / (horizon * horizon);
+    } else if (cooling_strategy == 3) {
+        return std::pow(final_temperature / t0, 1.0 / horizon);
+    }
+    return alpha;  // the logarithmic and adaptive schedules do not end where alpha sets them
+}
+
+Calibration calibrate_temperature(const std::vector<std::vector<int>> &jobs, const std::vector<int> &s,
+                                  int jobs_num, int machines_num, const std::vector<int> &deadlines,
+                                  Objective objective, const std::vector<MoveType> &moves, int cooling_strategy,
+                                  long long budget, double alpha, const CalibrationOptions &options,
+                                  const ObjectiveContext *context) {
+    Calibration calibration;
+    calibration.alpha = alpha;
+    // the floor of 50 samples must not eat more than 1% of a small budget
+    int samples = options.samples > 0
+                  ? options.samples
+                  : static_cast<int>(std::min(std::max(50LL, std::min(2000LL, budget / 200)),
+                                              std::max(1LL, budget / 100)));
+    if (jobs_num < 2) {
+        return calibration;
+    }
+    std::vector<MoveType> types = moves.empty() ? std::vector<MoveType>{MoveType::swap} : moves;
+    std::vector<int> values(samples);
+    int threads = std::max(1, std::min(options.threads, samples));
+    std::atomic<bool> overflow(false);
+    auto work = [&](int thread) {
+        SequenceEvaluator evaluator(jobs, jobs_num, machines_num, deadlines, objective, context);
+        std::vector<std::unique_ptr<MoveOperator>> operators;
+        for (MoveType type: types) {
+            operators.push_back(make_move_operator(type));
+        }
+        std::vector<int> sequence = s;
+        // an exception must not leave a worker thread, it is rethrown by the caller
+        try {
+            evaluator.rebase(s);
+            for (int k = thread; k < samples && !overflow; k += threads) {
+                // every sample has its own stream, so the samples do not depend on the thread count
+                std::mt19937 rng(options.seed ^ (static_cast<unsigned>(k) * 2654435761u));
+                const MoveOperator &op = *operators[k % operators.size()];
+                Move move = op.sample(jobs_num, rng);
+                op.apply(sequence, move);
+                values[k] = op.evaluate(evaluator, sequence, move);
+                op.undo(sequence, move);
+            }
+        } catch (std::overflow_error &) {
+            overflow = true;
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int thread = 1; thread < threads; ++thread) {
+        pool.emplace_back(work, thread);
+    }
+    work(0);
+    for (std::thread &thread: pool) {
+        thread.join();
+    }
+    if (overflow) {
+        throw std::overflow_error("an objective value of the calibration samples does not fit into an int");
+    }
+
+    SequenceEvaluator evaluator(jobs, jobs_num, machines_num, deadlines, objective, context);
+    int base = evaluator.rebase(s);
+    std::vector<double> deltas;
+    for (int value: values) {
+        if (value > base) {
+            deltas.push_back(value - base);
+        }
+    }
+    calibration.samples = samples;
+    calibration.uphill = deltas.size();
+    if (deltas.empty()) {
+        return calibration;
+    }
+    std::sort(deltas.begin(), deltas.end());
+    calibration.median_delta = deltas[deltas.size() / 2];
+
+    // the mean acceptance grows with the temperature, so bisect on a log scale
+    double low = deltas.front() * 1e-3;
+    double high = deltas.back() * 1e3;
+    for (int step = 0; step < 100; ++step) {
+        double middle = std::sqrt(low * high);
+        if (mean_acceptance(deltas, middle) < options.initial_acceptance) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    // the engine runs with an int temperature, so t0 is rounded before alpha is fitted to it
+    calibration.t0 = std::max(1.0, std::round(std::min(std::sqrt(low * high), static_cast<double>(INT_MAX))));
+    calibration.final_temperature = -calibration.median_delta / std::log(options.final_acceptance);
+    if (calibration.final_temperature >= calibration.t0) {
+        calibration.final_temperature = calibration.t0 * 1e-3;
+    }
+    calibration.alpha = fit_alpha(cooling_strategy, calibration.t0, calibration.final_temperature,
+                                  static_cast<double>(std::max(1LL, budget)), alpha);
+    return calibration;
+}
@@ -0,0 +1,87 @@
+#ifndef TEMPERATURE_CALIBRATION_H
+#define TEMPERATURE_CALIBRATION_H
+
+#include <vector>
+#include "neighborhood.h"
+#include "sequence_evaluator.h"
+
+/**
+ * @brief Struct representing the settings of the temperature calibration.
+ *
+ * - samples: The number of random neighbors evaluated, 0 takes 0.5% of the budget
+ *   (at least 50, at most 2000, and never more than 1% of the budget).
+ * - initial_acceptance: The target probability of accepting an uphill move at t0.
+ * - final_acceptance: The target probability of accepting the median uphill move at
+ *   the end of the run, which alpha is fitted to.
+ * - threads: The number of threads evaluating the samples.
+ * - seed: The seed of the sampling; the result does not depend on the thread count.
+ */
+struct CalibrationOptions {
+    int samples = 0;
+    double initial_acceptance = 0.8;
+    double final_acceptance = 0.001;
+    int threads = 1;
+    unsigned seed = 1;
+};
+
+/**
+ * @brief Struct representing the result of the temperature calibration.
+ *
+ * - t0: The initial temperature, rounded to the int temperature the engine runs with.
+ * - final_temperature: The temperature the schedule should reach at the end of the run.
+ * - alpha: The cooling rate with which the cooling strategy reaches final_temperature
+ *   at the end of the run (unchanged for strategies whose end point alpha does not set).
+ * - samples: The number of neighbors evaluated.
+ * - uphill: The number of sampled neighbors worse than the start order.
+ * - median_delta: The median uphill delta.
+ */
+struct Calibration {
+    double t0 = 1;
+    double final_temperature = 1;
+    double alpha = 0.8;
+    int samples = 0;
+    int uphill = 0;
+    double median_delta = 0;
+};
+
+/**
+ * @brief Calibrate the initial temperature and cooling rate of a run.
+ *
+ * Random neighbors of the start order are evaluated in parallel and the uphill deltas
+ * are collected. t0 is the temperature at which the mean Metropolis acceptance
+ * probability of the sampled uphill moves equals initial_acceptance (Ben-Ameur's
+ * criterion, solved by bisection). The final temperature accepts the median uphill
+ * move with final_acceptance, and alpha is solved from the closed form of the
+ * cooling strategy so that it reaches the final temperature after the whole budget.
+ *
+ * @param jobs A 2D vector representing the processing times of jobs on each machine.
+ * @param s The start order.
+ * @param jobs_num The total number of jobs.
+ * @param machines_num The total number of machines.
+ * @param deadlines A vector representing the deadlines for each job.
+ * @param objective The objective of the run.
+ * @param moves The move operators of the run.
+ * @param cooling_strategy The cooling strategy of the run.
+ * @param budget The number of neighbors the run evaluates.
+ * @param alpha The cooling rate, returned for strategies alpha cannot fit.
+ * @param options The settings of the calibration, see CalibrationOptions.
+ * @param context Optional setups, job weights and combination, may be nullptr.
+ *
+ * @return Calibration The calibrated temperatures and cooling rate.
+ *
+ * @throws std::overflow_error If an objective value of a sample does not fit into an int.
+ */
+Calibration calibrate_temperature(const std::vector<std::vector<int>> &jobs,
+                                  const std::vector<int> &s,
+                                  int jobs_num,
+                                  int machines_num,
+                                  const std::vector<int> &deadlines,
+                                  Objective objective,
+                                  const std::vector<MoveType> &moves,
+                                  int cooling_strategy,
+                                  long long budget,
+                                  double alpha,
+                                  const CalibrationOptions &options,
+                                  const ObjectiveContext *context = nullptr);
+
+#endif // TEMPERATURE_CALIBRATION_H
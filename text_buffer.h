@@ -0,0 +1,59 @@
+#ifndef TEXT_BUFFER_H
+#define TEXT_BUFFER_H
+
+#include <string>
+
+/**
+ * @brief Append the decimal representation of an integer to a buffer.
+ *
+ * Formats into a small stack array and appends it in one go, avoiding the stream
+ * machinery and temporary strings of std::to_string or operator<<.
+ *
+ * @param buffer The buffer the number is appended to.
+ * @param value The number.
+ */
+inline void append_int(std::string &buffer, long long value) {
+    char digits[24];
+    int length = 0;
+    unsigned long long magnitude = value < 0 ? 0ULL - static_cast<unsigned long long>(value)
+                                             : static_cast<unsigned long long>(value);
+    do {
+        digits[length++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0) {
+        digits[length++] = '-';
+    }
+    while (length > 0) {
+        buffer.push_back(digits[--length]);
+    }
+}
+
+/**
+ * @brief Append a fixed-point decimal number with the given number of decimals.
+ *
+ * @param buffer The buffer the number is appended to.
+ * @param value The number.
+ * @param decimals The number of decimals (at most 9).
+ */
+inline void append_fixed(std::string &buffer, double value, int decimals) {
+    long long scale = 1;
+    for (int i = 0; i < decimals; ++i) {
+        scale *= 10;
+    }
+    long long scaled = static_cast<long long>(value * scale + (value < 0 ? -0.5 : 0.5));
+    if (scaled < 0) {
+        buffer.push_back('-');
+        scaled = -scaled;
+    }
+    append_int(buffer, scaled / scale);
+    if (decimals > 0) {
+        buffer.push_back('.');
+        long long fraction = scaled % scale;
+        for (long long digit = scale / 10; digit > 0; digit /= 10) {
+            buffer.push_back(static_cast<char>('0' + fraction / digit % 10));
+        }
+    }
+}
+
+#endif // TEXT_BUFFER_H
@@ -0,0 +1,48 @@
+#include "time_width.h"
+#include <climits>
+#include <stdexcept>
+
+long long completion_time_bound(const std::vector<std::vector<int>> &jobs, int jobs_num, int machines_num,
+                                const SetupTimes *setups) {
+    long long bound = 0;
+    for (int j = 0; j < jobs_num; ++j) {
+        for (int i = 0; i < machines_num; ++i) {
+            bound += jobs[j][i];
+        }
+    }
+    return setups != nullptr ? bound + setups->bound() : bound;
+}
+
+long long tardiness_bound(long long completion_bound, const std::vector<int> &deadlines) {
+    int earliest = deadlines.empty() ? 0 : *std::min_element(deadlines.begin(), deadlines.end());
+    long long jobs_num = std::max<std::size_t>(1, deadlines.size());
+    return jobs_num * (completion_bound - std::min(0, earliest));
+}
+
+TimeWidth choose_time_width(long long bound) {
+    if (bound <= UINT16_MAX) {
+        return TimeWidth::w16;
+    } else if (bound <= INT32_MAX) {
+        return TimeWidth::w32;
+    }
+    return TimeWidth::w64;
+}
+
+std::string time_width_name(TimeWidth width) {
+    std::string name;
+    if (width == TimeWidth::w16) {
+        name = "16-bit";
+    } else if (width == TimeWidth::w32) {
+        name = "32-bit";
+    } else if (width == TimeWidth::w64) {
+        name = "64-bit";
+    }
+    return name;
+}
+
+int checked_value(long long value) {
+    if (value > INT_MAX || value < INT_MIN) {
+        throw std::overflow_error("objective value " + std::to_string(value) + " does not fit into an int");
+    }
+    return static_cast<int>(value);
+}
@@ -0,0 +1,109 @@
+#ifndef TIME_WIDTH_H
+#define TIME_WIDTH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "setup_times.h"
+
+/**
+ * @brief Integer widths the completion-time kernels run in.
+ *
+ * - w16: uint16_t, for instances whose completion times stay below 2^16. The machine
+ *   completion times kept per position take half the memory of the 32-bit kernel.
+ * - w32: int32_t, the width of the rest of the solver.
+ * - w64: int64_t, for instances whose completion times may not fit into 32 bits.
+ */
+enum class TimeWidth {
+    w16,
+    w32,
+    w64
+};
+
+/**
+ * @brief Calculate an upper bound of every completion time of an instance.
+ *
+ * No order finishes later than one that runs the jobs one after the other, so the
+ * sum of all processing times, plus the largest setup in front of every job, bounds
+ * every completion time. The bound is exact in 64 bits for any instance whose times
+ * fit into 32 bits.
+ *
+ * @param jobs A 2D vector representing the processing times of jobs on each machine.
+ * @param jobs_num The total number of jobs.
+ * @param machines_num The total number of machines.
+ * @param setups Optional sequence-dependent setup times, may be nullptr.
+ *
+ * @return long long The bound.
+ */
+long long completion_time_bound(const std::vector<std::vector<int>> &jobs,
+                                int jobs_num,
+                                int machines_num,
+                                const SetupTimes *setups = nullptr);
+
+/**
+ * @brief Calculate an upper bound of the total tardiness of every order of an instance.
+ *
+ * No job is later than the completion-time bound minus its deadline, so jobs_num
+ * times the largest such difference bounds the sum; it also bounds the makespan.
+ *
+ * @param completion_bound A bound of every completion time, see completion_time_bound().
+ * @param deadlines The deadline of every job.
+ *
+ * @return long long The bound.
+ */
+long long tardiness_bound(long long completion_bound, const std::vector<int> &deadlines);
+
+/**
+ * @brief Pick the narrowest width that holds every completion time up to a bound.
+ */
+TimeWidth choose_time_width(long long bound);
+
+/**
+ * @brief Get the name of a width, e.g. "16-bit".
+ */
+std::string time_width_name(TimeWidth width);
+
+/**
+ * @brief Convert a 64-bit objective value to the int the solver works with.
+ *
+ * @throws std::overflow_error If the value does not fit into an int.
+ */
+int checked_value(long long value);
+
+/**
+ * @brief Append a job to a partial schedule in the completion-time type T.
+ *
+ * The width-generic counterpart of append_with_setup(): state holds the machine
+ * completion times of the partial schedule and is replaced by those after the job.
+ * T must hold every completion time of the instance, see choose_time_width().
+ *
+ * @param processing The m processing times of the job.
+ * @param setup The m setup times before the job, nullptr for none.
+ * @param machines_num The total number of machines.
+ * @param state The completion times on every machine, updated in place.
+ *
+ * @return T The completion time of the job on the last machine.
+ */
+template<typename T>
+inline T append_job(const T *processing, const int *setup, int machines_num, T *state) {
+    if (setup != nullptr) {
+        for (int i = 0; i < machines_num; ++i) {
+            state[i] = static_cast<T>(state[i] + setup[i]);
+        }
+    }
+    T c = 0;
+    for (int i = 0; i < machines_num; ++i) {
+        c = static_cast<T>(std::max(c, state[i]) + processing[i]);
+        state[i] = c;
+    }
+    return c;
+}
+
+// the 32-bit kernel adds the setups in SIMD registers
+template<>
+inline int32_t append_job<int32_t>(const int32_t *processing, const int *setup, int machines_num, int32_t *state) {
+    return append_with_setup(processing, setup, machines_num, state);
+}
+
+#endif // TIME_WIDTH_H
@@ -0,0 +1,204 @@
+#include "tuner.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+static std::vector<TunedConfig> candidate_configs(const RacingOptions &racing) {
+    std::vector<TunedConfig> configs;
+    for (int strategy: racing.strategies) {
+        for (double alpha: racing.alphas) {
+            for (int neighbors: racing.neighbors) {
+                for (int t0: racing.t0s) {
+                    TunedConfig config;
+                    config.cooling_strategy = strategy;
+                    config.alpha = alpha;
+                    config.neighbors = neighbors;
+                    config.t0 = t0;
+                    configs.push_back(config);
+                }
+            }
+        }
+    }
+    return configs;
+}
+
+// Objective value of one run of a configuration on one instance and seed
+static int run_config(const TunedConfig &config, Objective objective, const std::vector<std::vector<int>> &jobs,
+                      const Instance &instance, unsigned seed, ObjectFunction object_f,
+                      const AnnealingOptions &options, long long budget) {
+    int n = instance.jobs_num;
+    int m = instance.machines_num;
+    std::vector<int> start(n);
+    for (int j = 0; j < n; ++j) {
+        start[j] = j + 1;
+    }
+    std::shuffle(start.begin(), start.end(), std::mt19937(seed));
+    AnnealingOptions run_options = options;
+    run_options.alpha = config.alpha;
+    run_options.seed = seed;
+    run_options.lower_bound = trivial_lower_bound(objective, options.combination);
+    int iterations = static_cast<int>(std::max(1LL, budget / config.neighbors));
+    AnnealingStats stats;
+    run_options.job_weights = instance.weights;
+    simulated_annealing(objective, jobs, start, object_f, iterations, config.neighbors, config.t0, n, m,
+                        config.cooling_strategy, instance.deadlines, run_options, &stats);
+    return stats.overflow.empty() ? stats.best_value : INT_MAX;
+}
+
+// Paired one-sided t-test: true if the scores of a are significantly higher than those of b
+static bool significantly_worse(const std::vector<double> &a, const std::vector<double> &b,
+                                const std::vector<double> &critical_values) {
+    std::size_t k = a.size();
+    double mean = 0;
+    for (std::size_t r = 0; r < k; ++r) {
+        mean += a[r] - b[r];
+    }
+    mean /= k;
+    double variance = 0;
+    for (std::size_t r = 0; r < k; ++r) {
+        double deviation = a[r] - b[r] - mean;
+        variance += deviation * deviation;
+    }
+    variance /= k - 1;
+    if (variance == 0) {
+        return mean > 0;
+    }
+    double critical = critical_values[std::min(k - 2, critical_values.size() - 1)];
+    return mean / std::sqrt(variance / k) > critical;
+}
+
+TunedConfig race_configurations(const SweepSpec &spec, const std::vector<Instance> &instances,
+                                ObjectFunction object_f, const AnnealingOptions &options,
+                                const RacingOptions &racing, RacingStats *stats) {
+    std::vector<TunedConfig> configs = candidate_configs(racing);
+    Objective objective = spec.objectives.empty() ? Objective::c_max : spec.objectives.front();
+    AnnealingOptions race_options = options;
+    race_options.combination = spec.combination;
+    std::vector<std::vector<std::vector<int>>> matrices;
+    for (const Instance &instance: instances) {
+        matrices.push_back(jobs_matrix(instance));
+    }
+    // races alternate instances first, so early eliminations see every instance
+    std::vector<std::pair<int, unsigned>> races;
+    for (int seed: spec.seeds) {
+        for (std::size_t k = 0; k < instances.size(); ++k) {
+            races.push_back(std::make_pair(static_cast<int>(k), static_cast<unsigned>(seed)));
+        }
+    }
+
+    std::vector<int> alive(configs.size());
+    for (std::size_t c = 0; c < configs.size(); ++c) {
+        alive[c] = c;
+    }
+    std::vector<std::vector<double>> scores(configs.size());
+    int threads = racing.threads > 0 ? racing.threads : std::max(1u, std::thread::hardware_concurrency());
+    long long runs = 0;
+    int races_run = 0;
+    for (const std::pair<int, unsigned> &race: races) {
+        if (alive.size() < 2 && races_run > 0) {
+            break;
+        }
+        std::vector<int> values(alive.size());
+        std::atomic<std::size_t> next(0);
+        auto work = [&]() {
+            for (std::size_t a = next++; a < alive.size(); a = next++) {
+                values[a] = run_config(configs[alive[a]], objective, matrices[race.first], instances[race.first],
+                                       race.second, object_f, race_options, racing.budget);
+            }
+        };
+        std::vector<std::thread> pool;
+        for (int thread = 1; thread < std::min<int>(threads, alive.size()); ++thread) {
+            pool.emplace_back(work);
+        }
+        work();
+        for (std::thread &thread: pool) {
+            thread.join();
+        }
+        runs += alive.size();
+        ++races_run;
+
+        int best_value = *std::min_element(values.begin(), values.end());
+        for (std::size_t a = 0; a < alive.size(); ++a) {
+            scores[alive[a]].push_back(static_cast<double>(values[a] - best_value) / std::max(best_value, 1));
+        }
+        if (races_run < std::max(2, racing.first_test)) {
+            continue;
+        }
+        // eliminate against the configuration with the best mean score so far
+        auto mean_score = [&](int c) {
+            double sum = 0;
+            for (double score: scores[c]) {
+                sum += score;
+            }
+            return sum / scores[c].size();
+        };
+        int leader = *std::min_element(alive.begin(), alive.end(), [&](int a, int b) {
+            return mean_score(a) < mean_score(b);
+        });
+        std::vector<int> survivors;
+        for (int c: alive) {
+            if (c == leader || !significantly_worse(scores[c], scores[leader], racing.critical_values)) {
+                survivors.push_back(c);
+            }
+        }
+        alive.swap(survivors);
+    }
+
+    int winner = alive.front();
+    double winner_score = 0;
+    for (int c: alive) {
+        double sum = 0;
+        for (double score: scores[c]) {
+            sum += score;
+        }
+        double mean = scores[c].empty() ? 0 : sum / scores[c].size();
+        if (c == alive.front() || mean < winner_score) {
+            winner = c;
+            winner_score = mean;
+        }
+    }
+    if (stats != nullptr) {
+        stats->configurations = configs.size();
+        stats->races = races_run;
+        stats->runs = runs;
+        stats->survivors = alive.size();
+        stats->mean_score = winner_score;
+    }
+    return configs[winner];
+}
+
+bool save_config(const std::string &path, const TunedConfig &config) {
+    std::FILE *file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+    int written = std::fprintf(file, "# annealing schedule\ncooling_strategy = %d\nalpha = %.6g\nneighbors = %d\n"
+                                     "t0 = %d\n", config.cooling_strategy, config.alpha, config.neighbors, config.t0);
+    return std::fclose(file) == 0 && written > 0;
+}
+
+bool load_config(const std::string &path, TunedConfig &config, std::string &error) {
+    return read_settings(path, [&config](const std::string &key, const std::string &value) {
+        try {
+            if (key == "cooling_strategy") {
+                config.cooling_strategy = std::stoi(value);
+            } else if (key == "alpha") {
+                config.alpha = std::stod(value);
+            } else if (key == "neighbors") {
+                config.neighbors = std::stoi(value);
+            } else if (key == "t0") {
+                config.t0 = std::stoi(value);
+            } else {
+                return false;
+            }
+        } catch (std::logic_error &) {
+            return false;
+        }
+        return true;
+    }, error);
+}
@@ -0,0 +1,115 @@
+#ifndef TUNER_H
+#define TUNER_H
+
+#include <string>
+#include <vector>
+#include "batch_runner.h"
+
+/**
+ * @brief Struct representing a configuration of the annealing schedule.
+ *
+ * - cooling_strategy: The cooling strategy, see choose_cooling_strategy().
+ * - alpha: The cooling rate.
+ * - neighbors: The epoch length, the number of neighbors considered at each iteration.
+ * - t0: The initial temperature.
+ */
+struct TunedConfig {
+    int cooling_strategy = 3;
+    double alpha = 0.8;
+    int neighbors = 100;
+    int t0 = 100;
+};
+
+/**
+ * @brief Struct representing the settings of the racing tuner.
+ *
+ * Every combination of the candidate lists is a configuration. Configurations are
+ * compared at an equal budget: a configuration runs budget / neighbors iterations.
+ *
+ * - strategies, alphas, neighbors, t0s: The candidate values.
+ * - budget: The number of neighbors evaluated by every run.
+ * - first_test: The number of races run before configurations are first eliminated.
+ * - critical_values: One-sided 95% critical values of Student's t distribution by
+ *   degrees of freedom (1 first); the last value is used for larger samples.
+ * - threads: The number of threads running a race, 0 uses every hardware thread.
+ */
+struct RacingOptions {
+    std::vector<int> strategies = {1, 2, 3, 4, 5, 6};
+    std::vector<double> alphas = {0.8, 0.9, 0.95, 0.99};
+    std::vector<int> neighbors = {50, 100, 200};
+    std::vector<int> t0s = {10, 100, 1000};
+    long long budget = 20000;
+    int first_test = 5;
+    std::vector<double> critical_values = {6.314, 2.920, 2.353, 2.132, 2.015, 1.943, 1.895, 1.860, 1.833, 1.812,
+                                           1.796, 1.782, 1.771, 1.761, 1.753, 1.746, 1.740, 1.734, 1.729, 1.725,
+                                           1.721, 1.717, 1.714, 1.711, 1.708, 1.706, 1.703, 1.701, 1.699, 1.697,
+                                           1.645};
+    int threads = 0;
+};
+
+/**
+ * @brief Struct representing the statistics of a race.
+ *
+ * - configurations: The number of configurations entered.
+ * - races: The number of instance and seed pairs the survivors were run on.
+ * - runs: The number of annealing runs.
+ * - survivors: The number of configurations left at the end.
+ * - mean_score: The mean relative deviation of the winner from the best value of each race.
+ */
+struct RacingStats {
+    int configurations = 0;
+    int races = 0;
+    long long runs = 0;
+    int survivors = 0;
+    double mean_score = 0;
+};
+
+/**
+ * @brief Tune the annealing schedule by racing configurations over a training set.
+ *
+ * Every race runs all surviving configurations on one instance and seed of the
+ * training set in parallel and scores each run by its relative deviation from the
+ * best value of the race. After first_test races, and after every race from then
+ * on, a configuration is eliminated when a paired one-sided t-test over the races
+ * so far shows that it is worse than the configuration with the best mean score.
+ * The race ends when one configuration is left or the training set is exhausted.
+ *
+ * @param spec The training set: its instances, first objective and seeds are used.
+ * @param instances The instances of the training set, see sweep_instances().
+ * @param object_f A function to calculate the objective function result of an order.
+ * @param options The settings of the engine; alpha and the seed are set per run, the
+ * weighted_sum coefficients come from the specification.
+ * @param racing The settings of the tuner, see RacingOptions.
+ * @param stats Optional output for the statistics of the race, may be nullptr.
+ *
+ * @return TunedConfig The surviving configuration with the best mean score.
+ */
+TunedConfig race_configurations(const SweepSpec &spec,
+                                const std::vector<Instance> &instances,
+                                ObjectFunction object_f,
+                                const AnnealingOptions &options,
+                                const RacingOptions &racing,
+                                RacingStats *stats = nullptr);
+
+/**
+ * @brief Write a configuration file with one "key = value" line per setting.
+ *
+ * @param path The path of the file.
+ * @param config The configuration.
+ *
+ * @return bool True if the file was written completely.
+ */
+bool save_config(const std::string &path, const TunedConfig &config);
+
+/**
+ * @brief Read a configuration file written by save_config().
+ *
+ * @param path The path of the file.
+ * @param config Output for the configuration; keys missing from the file keep their values.
+ * @param error Output for a description of the first problem found.
+ *
+ * @return bool True if the file was read and every line is valid.
+ */
+bool load_config(const std::string &path, TunedConfig &config, std::string &error);
+
+#endif // TUNER_H